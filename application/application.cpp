@@ -28,6 +28,9 @@ bool Application::init(const int& width, const int& height) {
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);// specify OpenGL version
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);// specify OpenGL version
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef GL_DEBUG_CONTEXT
+	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE); // 调试上下文：驱动完整报告 KHR_debug 消息
+#endif
 	mWindow = glfwCreateWindow(mWidth, mHeight, "LearnOpenGL", nullptr, nullptr); // create window
 	if(mWindow == nullptr) return false; // check if window creation was successful
 	glfwMakeContextCurrent(mWindow); //make the window context currently active
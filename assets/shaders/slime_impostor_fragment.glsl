@@ -0,0 +1,42 @@
+﻿#version 330 core
+out vec4 FragColor;
+
+in vec3 vViewPos;
+in vec3 vViewCenter;
+in float vRadius;
+
+uniform vec3 uSlimeColor;
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uCameraPos;
+    float uTime;
+};
+
+void main()
+{
+    // 视图空间中相机位于原点，沿视线与球体求交
+    vec3 rayDir = normalize(vViewPos);
+    float b = dot(rayDir, vViewCenter);
+    float c = dot(vViewCenter, vViewCenter) - vRadius * vRadius;
+    float disc = b * b - c;
+    if (disc < 0.0) discard;   // 视线未命中球体
+    
+    float t = b - sqrt(disc);  // 最近交点
+    vec3 hitPos = rayDir * t;
+    vec3 viewNormal = (hitPos - vViewCenter) / vRadius;
+    
+    // 写入交点的真实深度，使粒子之间及与场景正确遮挡
+    vec4 clipPos = uProjection * vec4(hitPos, 1.0);
+    float ndcDepth = clipPos.z / clipPos.w;
+    gl_FragDepth = ((gl_DepthRange.diff * ndcDepth) + gl_DepthRange.near + gl_DepthRange.far) * 0.5;
+    
+    // 视图矩阵为刚体变换，转置即可把法线变回世界空间（与粒子模式光照一致）
+    vec3 norm = normalize(transpose(mat3(uView)) * viewNormal);
+    vec3 lightDir = normalize(vec3(1.0, 1.0, 1.0)); // 固定光源方向
+    
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = uSlimeColor * (0.5 + 0.5 * diff); // 保证至少有50%亮度
+    
+    FragColor = vec4(diffuse, 1.0);
+}
@@ -0,0 +1,31 @@
+﻿#version 330 core
+layout (location = 0) in vec2 aCorner;     // 四边形角点 [-1, 1]
+
+// 实例化属性 - 紧凑格式：xyz 为粒子位置，w 为粒子半径
+layout (location = 3) in vec4 aInstance;
+
+out vec3 vViewPos;      // 四边形上的视图空间位置（用于构造视线）
+out vec3 vViewCenter;   // 球心（视图空间）
+out float vRadius;      // 球半径
+
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uCameraPos;
+    float uTime;
+};
+
+void main()
+{
+    vec4 viewCenter = uView * vec4(aInstance.xyz, 1.0);
+    float radius = aInstance.w;
+    
+    // 在球心深度展开朝向相机的四边形；放大 1.5 倍以覆盖透视下被拉伸的球体轮廓
+    vec3 viewPos = viewCenter.xyz + vec3(aCorner * radius * 1.5, 0.0);
+    
+    vViewPos = viewPos;
+    vViewCenter = viewCenter.xyz;
+    vRadius = radius;
+    
+    gl_Position = uProjection * vec4(viewPos, 1.0);
+}
@@ -5,8 +5,12 @@ in vec3 FragPos;
 in vec3 Normal;
 
 uniform vec3 uSlimeColor;
-uniform vec3 uCameraPos;
-uniform float uTime;
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uCameraPos;
+    float uTime;
+};
 
 // 光源位置
 const vec3 lightPos = vec3(10.0, 20.0, 10.0);
@@ -0,0 +1,22 @@
+﻿#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 4) in mat4 aInstanceModel; // 每实例模型矩阵（占 location 4~7）
+
+out vec2 TexCoord;
+out vec3 Normal;
+
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uCameraPos;
+    float uTime;
+};
+
+void main()
+{
+    gl_Position = uProjection * uView * aInstanceModel * vec4(aPos, 1.0);
+    TexCoord = aTexCoord;
+    Normal = mat3(transpose(inverse(aInstanceModel))) * aNormal; // 变换法线到世界空间
+}
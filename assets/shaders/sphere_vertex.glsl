@@ -7,8 +7,12 @@ out vec2 TexCoord;
 out vec3 Normal;
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uCameraPos;
+    float uTime;
+};
 
 void main()
 {
@@ -0,0 +1,21 @@
+#version 460 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTex;
+layout (location = 4) in mat4 aInstanceModel; // 每实例模型矩阵（占 location 4~7）
+
+out vec3 vPos;
+out vec2 vTex;
+
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uCameraPos;
+    float uTime;
+};
+
+void main()
+{
+    gl_Position =  uProjection * uView * aInstanceModel * vec4(aPos, 1.0);
+    vPos = aPos;
+    vTex = aTex;
+}
@@ -0,0 +1,139 @@
+﻿#include "../engine/engine.h"
+#include "../engine/scene.h"
+#include "../engine/profiler.h"
+#include "../engine/frameStats.h"
+#include "../engine/snapshot.h"
+#include "../engine/object/slime/slime.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        int frames{ 1000 };
+        int warmup{ 60 };
+        float dt{ 1.0f / 60.0f };
+        bool meshMode{ true };   // 默认走网格模式，覆盖连通域分析与 Marching Cubes
+        bool pipelined{ false };
+        std::string loadSnapshot;  // 预热前恢复的快照（跳过初始下落，直接测稳定状态）
+        std::string saveSnapshot;  // 预热后保存的快照
+    };
+
+    // 某个阶段每帧的耗时（所有线程之和）
+    struct StageSamples {
+        std::string name;
+        uint32_t depth{ 0 };
+        std::vector<double> ms;
+        uint64_t calls{ 0 };
+    };
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+                options.frames = std::max(1, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+                options.warmup = std::max(0, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) {
+                options.dt = static_cast<float>(std::atof(argv[++i]));
+            } else if (std::strcmp(argv[i], "--particles") == 0) {
+                options.meshMode = false;
+            } else if (std::strcmp(argv[i], "--pipelined") == 0) {
+                options.pipelined = true;
+            } else if (std::strcmp(argv[i], "--load-snapshot") == 0 && i + 1 < argc) {
+                options.loadSnapshot = argv[++i];
+            } else if (std::strcmp(argv[i], "--save-snapshot") == 0 && i + 1 < argc) {
+                options.saveSnapshot = argv[++i];
+            }
+        }
+        return options;
+    }
+
+    StageSamples& findStage(std::vector<StageSamples>& stages, const std::string& name, uint32_t depth, size_t frameIndex) {
+        auto it = std::find_if(stages.begin(), stages.end(), [&name](const StageSamples& s) { return s.name == name; });
+        if (it != stages.end()) return *it;
+        StageSamples stage;
+        stage.name = name;
+        stage.depth = depth;
+        stage.ms.assign(frameIndex, 0.0);  // 之前的帧没有出现该阶段
+        stages.push_back(std::move(stage));
+        return stages.back();
+    }
+}
+
+/**
+ * @brief 无头基准：以固定 dt 推进演示场景 N 帧，输出各阶段耗时分位数
+ * 用法：glStudyBench [--frames N] [--warmup N] [--dt 秒] [--particles] [--pipelined]
+ *                    [--load-snapshot path] [--save-snapshot path]
+ */
+int main(int argc, char** argv) {
+    const Options options = parseOptions(argc, argv);
+
+    auto engine = new Engine();
+    engine->initHeadless();
+    engine->setupDemoData();
+    engine->scene->setPhysicsPipelined(options.pipelined);
+    for (Slime* slime : engine->scene->findObjectsByType<Slime>()) {
+        slime->setRenderMode(options.meshMode ? Slime::RenderMode::MESH : Slime::RenderMode::PARTICLES);
+    }
+
+    if (!options.loadSnapshot.empty() && !engine->snapshot->load(options.loadSnapshot)) {
+        delete engine;
+        return 1;
+    }
+
+    Profiler& profiler = Profiler::instance();
+    profiler.setEnabled(true);  // 分阶段耗时来自分析器
+    for (int i = 0; i < options.warmup; ++i) {
+        engine->scene->update(options.dt);
+        profiler.endFrame();
+    }
+    if (!options.saveSnapshot.empty()) {
+        engine->snapshot->save(options.saveSnapshot);
+    }
+
+    std::vector<StageSamples> stages;
+    std::vector<double> frameMs;
+    frameMs.reserve(options.frames);
+    for (int frame = 0; frame < options.frames; ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        engine->scene->update(options.dt);
+        frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        profiler.endFrame();
+
+        // 同名区段（不同父节点或不同线程）合并为一个阶段
+        for (auto& stage : stages) stage.ms.push_back(0.0);
+        for (const Profiler::ZoneStats& zone : profiler.getLastFrame()) {
+            StageSamples& stage = findStage(stages, zone.name, zone.depth, frame + 1);
+            stage.ms.back() += zone.totalMs;
+            stage.calls += zone.calls;
+        }
+    }
+
+    std::sort(frameMs.begin(), frameMs.end());
+    std::cout << "[Bench] " << options.frames << " 帧 | dt " << options.dt * 1000.0f << " ms | "
+              << (options.meshMode ? "网格模式" : "粒子模式") << (options.pipelined ? " | 流水线物理" : "") << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(48) << "stage" << std::right
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "max ms" << std::setw(12) << "calls/frame" << std::endl;
+    std::cout << std::left << std::setw(48) << "frame (wall)" << std::right
+              << std::setw(10) << FrameStats::percentile(frameMs, 0.50) << std::setw(10) << FrameStats::percentile(frameMs, 0.95)
+              << std::setw(10) << FrameStats::percentile(frameMs, 0.99) << std::setw(10) << frameMs.back()
+              << std::setw(12) << 1.0 << std::endl;
+    for (auto& stage : stages) {
+        std::sort(stage.ms.begin(), stage.ms.end());
+        std::cout << std::left << std::setw(48) << (std::string(stage.depth * 2, ' ') + stage.name) << std::right
+                  << std::setw(10) << FrameStats::percentile(stage.ms, 0.50) << std::setw(10) << FrameStats::percentile(stage.ms, 0.95)
+                  << std::setw(10) << FrameStats::percentile(stage.ms, 0.99) << std::setw(10) << stage.ms.back()
+                  << std::setw(12) << static_cast<double>(stage.calls) / options.frames << std::endl;
+    }
+
+    delete engine;
+    return 0;
+}
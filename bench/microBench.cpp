@@ -0,0 +1,303 @@
+﻿#include "../engine/engine.h"
+#include "../engine/profiler.h"
+#include "../engine/object/slime/slime.h"
+#include "../engine/object/slime/connectedComponents.h"
+#include "../engine/object/slime/densityField.h"
+#include "../engine/object/slime/marchingCubes.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr float PARTICLE_RADIUS = 0.12f;             // 与演示场景的史莱姆一致
+    constexpr float PARTICLE_SPACING = PARTICLE_RADIUS * 2.0f;
+    constexpr float SEARCH_RADIUS = PARTICLE_RADIUS * 4.0f;
+
+    struct Options {
+        int reps{ 15 };
+        int resolution{ 28 };        // 密度场分辨率（与 Slime 默认值一致）
+        int blurIterations{ 6 };
+        uint32_t seed{ 12345 };
+        std::vector<int> sizes{ 1000, 10000, 100000 };
+        std::string jsonPath;        // 为空时不写 JSON
+    };
+
+    // 一组合成输入
+    struct Scenario {
+        std::string name;
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> velocities;
+    };
+
+    // 一次测量的统计结果
+    struct Result {
+        std::string scenario;
+        std::string kernel;
+        int particles{ 0 };
+        int64_t voxels{ 0 };         // 0 表示该阶段不按体素计
+        std::vector<double> samplesNs;
+        double medianNs{ 0.0 };
+        double minNs{ 0.0 };
+        double meanNs{ 0.0 };
+        double stddevNs{ 0.0 };
+    };
+
+    glm::vec3 jitter(std::mt19937& gen) {
+        std::uniform_real_distribution<float> dist(-0.1f, 0.1f);
+        return glm::vec3(dist(gen), dist(gen), dist(gen)) * PARTICLE_SPACING;
+    }
+
+    // 规则网格填充一个长方体，count 个粒子按 dims 比例排布
+    void fillBox(std::vector<glm::vec3>& out, int count, const glm::vec3& origin, const glm::vec3& aspect, std::mt19937& gen) {
+        const float scale = std::cbrt(count / (aspect.x * aspect.y * aspect.z));
+        const glm::ivec3 dims = glm::max(glm::ivec3(glm::ceil(aspect * scale)), glm::ivec3(1));
+        for (int i = 0; i < count; ++i) {
+            const glm::ivec3 cell(i % dims.x, (i / dims.x) % dims.y, i / (dims.x * dims.y));
+            out.push_back(origin + glm::vec3(cell) * PARTICLE_SPACING + jitter(gen));
+        }
+    }
+
+    // 均匀方块：静止的立方体粒子块
+    Scenario makeUniformBlock(int count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        Scenario s{ "uniform_block" };
+        fillBox(s.positions, count, glm::vec3(0.0f), glm::vec3(1.0f), gen);
+        s.velocities.assign(count, glm::vec3(0.0f));
+        return s;
+    }
+
+    // 溃坝：70% 粒子为高柱，30% 为沿 +X 铺开的薄层
+    Scenario makeDamBreak(int count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        Scenario s{ "dam_break" };
+        const int columnCount = count * 7 / 10;
+        fillBox(s.positions, columnCount, glm::vec3(0.0f), glm::vec3(1.0f, 2.0f, 1.0f), gen);
+        s.velocities.assign(columnCount, glm::vec3(0.0f));
+
+        const int sheetCount = count - columnCount;
+        const float columnWidth = std::cbrt(columnCount / 2.0f) * PARTICLE_SPACING;
+        fillBox(s.positions, sheetCount, glm::vec3(columnWidth, 0.0f, 0.0f), glm::vec3(16.0f, 0.25f, 2.0f), gen);
+        s.velocities.resize(count, glm::vec3(2.0f, 0.0f, 0.0f));
+        return s;
+    }
+
+    // 飞溅液滴：每 50 个粒子一滴，随机散布在立方体空间中并带随机速度
+    Scenario makeDroplets(int count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        Scenario s{ "droplets" };
+        constexpr int dropletSize = 50;
+        const int dropletCount = std::max(1, count / dropletSize);
+        const float extent = std::cbrt(static_cast<float>(dropletCount)) * 1.5f;
+        std::uniform_real_distribution<float> center(0.0f, extent);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> speed(-3.0f, 3.0f);
+        const float dropletRadius = std::cbrt(dropletSize * 0.75f / 3.14159265f) * PARTICLE_SPACING;
+
+        glm::vec3 c(0.0f), v(0.0f);
+        for (int i = 0; i < count; ++i) {
+            if (i % dropletSize == 0) {
+                c = glm::vec3(center(gen), center(gen), center(gen));
+                v = glm::vec3(speed(gen), speed(gen), speed(gen));
+            }
+            glm::vec3 offset;
+            do {
+                offset = glm::vec3(unit(gen), unit(gen), unit(gen));
+            } while (glm::dot(offset, offset) > 1.0f);
+            s.positions.push_back(c + offset * dropletRadius);
+            s.velocities.push_back(v);
+        }
+        return s;
+    }
+
+    /**
+     * @brief 重复执行 reps 次（另加一次预热），每次先调用 setup（不计时）再计时 run
+     */
+    template<typename Setup, typename Run>
+    Result measure(int reps, Setup&& setup, Run&& run) {
+        Result result;
+        for (int i = -1; i < reps; ++i) {
+            setup();
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const auto end = std::chrono::steady_clock::now();
+            if (i >= 0) {
+                result.samplesNs.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+        }
+
+        std::vector<double> sorted = result.samplesNs;
+        std::sort(sorted.begin(), sorted.end());
+        result.medianNs = sorted[sorted.size() / 2];
+        result.minNs = sorted.front();
+        for (double ns : sorted) result.meanNs += ns;
+        result.meanNs /= sorted.size();
+        for (double ns : sorted) result.stddevNs += (ns - result.meanNs) * (ns - result.meanNs);
+        result.stddevNs = std::sqrt(result.stddevNs / sorted.size());
+        return result;
+    }
+
+    Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+                options.reps = std::max(1, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--resolution") == 0 && i + 1 < argc) {
+                options.resolution = std::max(2, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+                // 逗号分隔，例如 --sizes 1000,10000
+                options.sizes.clear();
+                for (char* token = std::strtok(argv[++i], ","); token; token = std::strtok(nullptr, ",")) {
+                    options.sizes.push_back(std::max(1, std::atoi(token)));
+                }
+            } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+                options.jsonPath = argv[++i];
+            }
+        }
+        return options;
+    }
+
+    void writeJson(const std::string& path, const Options& options, const std::vector<Result>& results) {
+        std::ofstream out(path);
+        if (!out) {
+            std::cout << "[MicroBench] 无法写入 " << path << std::endl;
+            return;
+        }
+        out << std::fixed << std::setprecision(3);
+        out << "{\n  \"version\": 1,\n  \"seed\": " << options.seed << ",\n  \"reps\": " << options.reps
+            << ",\n  \"resolution\": " << options.resolution << ",\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "    {\"scenario\": \"" << r.scenario << "\", \"kernel\": \"" << r.kernel
+                << "\", \"particles\": " << r.particles << ", \"voxels\": " << r.voxels
+                << ", \"medianNs\": " << r.medianNs << ", \"minNs\": " << r.minNs
+                << ", \"meanNs\": " << r.meanNs << ", \"stddevNs\": " << r.stddevNs
+                << ", \"nsPerParticle\": " << r.medianNs / r.particles
+                << ", \"nsPerVoxel\": " << (r.voxels > 0 ? r.medianNs / r.voxels : 0.0) << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        std::cout << "[MicroBench] 结果已写入 " << path << std::endl;
+    }
+}
+
+/**
+ * @brief 直接调用 Slime 的私有模拟阶段（友元）
+ */
+class SlimeKernelBench {
+public:
+    static void load(Slime& slime, const Scenario& scenario) {
+        for (size_t i = 0; i < scenario.positions.size(); ++i) {
+            Slime::Particle& p = slime.m_particles[i];
+            p.position = scenario.positions[i];
+            p.predictedPos = scenario.positions[i];
+            p.velocity = scenario.velocities[i];
+            p.force = glm::vec3(0.0f);
+            p.lambda = 0.0f;
+            p.deltaPos = glm::vec3(0.0f);
+        }
+        neighborSearch(slime);
+    }
+
+    static void neighborSearch(Slime& slime) {
+        slime.buildSpatialHash();
+        slime.updateNeighbors();
+    }
+
+    static void solveConstraints(Slime& slime) { slime.solveConstraints(); }
+    static void applyViscosity(Slime& slime) { slime.applyViscosity(); }
+
+    static std::vector<Slime::Particle>& particles(Slime& slime) { return slime.m_particles; }
+};
+
+/**
+ * @brief 史莱姆模拟与网格生成各阶段的微基准
+ * 用法：glStudyMicroBench [--reps N] [--sizes 1000,10000,100000] [--resolution N] [--seed N] [--json path]
+ */
+int main(int argc, char** argv) {
+    const Options options = parseOptions(argc, argv);
+
+    // Slime 需要引擎指针；无头引擎不创建 GL 资源
+    auto engine = new Engine();
+    engine->initHeadless();
+    Profiler::instance().setEnabled(false);  // 只计内核本身
+
+    std::vector<Result> results;
+    auto record = [&results](Result result, const Scenario& scenario, const char* kernel, int64_t voxels) {
+        result.scenario = scenario.name;
+        result.kernel = kernel;
+        result.particles = static_cast<int>(scenario.positions.size());
+        result.voxels = voxels;
+        std::cout << std::left << std::setw(16) << scenario.name << std::setw(24) << kernel << std::right
+                  << std::setw(8) << result.particles << std::fixed << std::setprecision(3)
+                  << std::setw(12) << result.medianNs / 1e6 << " ms" << std::setw(10) << result.medianNs / result.particles << " ns/p";
+        if (voxels > 0) std::cout << std::setw(10) << result.medianNs / voxels << " ns/v";
+        std::cout << "  (±" << std::setprecision(1) << (result.meanNs > 0.0 ? 100.0 * result.stddevNs / result.meanNs : 0.0) << "%)" << std::endl;
+        results.push_back(std::move(result));
+    };
+
+    for (int size : options.sizes) {
+        const Scenario scenarios[] = {
+            makeUniformBlock(size, options.seed),
+            makeDamBreak(size, options.seed),
+            makeDroplets(size, options.seed),
+        };
+
+        for (const Scenario& scenario : scenarios) {
+            const int count = static_cast<int>(scenario.positions.size());
+
+            // ===== Slime 模拟阶段 =====
+            Slime slime(engine, glm::vec3(0.0f), 1.0f, count, nullptr, nullptr, 0);
+            slime.setParticleRadius(PARTICLE_RADIUS);
+            slime.setRestDensity(50.0f);
+            SlimeKernelBench::load(slime, scenario);
+            const std::vector<Slime::Particle> initial = SlimeKernelBench::particles(slime);
+            auto restore = [&]() { SlimeKernelBench::particles(slime) = initial; };
+
+            record(measure(options.reps, restore, [&]() { SlimeKernelBench::neighborSearch(slime); }),
+                   scenario, "Slime::neighborSearch", 0);
+            record(measure(options.reps, restore, [&]() { SlimeKernelBench::solveConstraints(slime); }),
+                   scenario, "Slime::solveConstraints", 0);
+            record(measure(options.reps, restore, [&]() { SlimeKernelBench::applyViscosity(slime); }),
+                   scenario, "Slime::applyViscosity", 0);
+
+            // ===== 网格生成阶段（整个输入作为一个密度场） =====
+            ConnectedComponents components;
+            record(measure(options.reps, []() {}, [&]() { components.analyzeComponents(scenario.positions, SEARCH_RADIUS, 2); }),
+                   scenario, "ConnectedComponents", 0);
+
+            ComponentInfo bounds;
+            bounds.particlePositions = scenario.positions;
+            bounds.computeBounds();
+            DensityField field(bounds.boundsMin, bounds.boundsMax, options.resolution);
+            const int64_t voxels = static_cast<int64_t>(options.resolution) * options.resolution * options.resolution;
+
+            record(measure(options.reps, []() {}, [&]() { field.buildFromParticles(scenario.positions, PARTICLE_RADIUS); }),
+                   scenario, "DensityField::build", voxels);
+            record(measure(options.reps, [&]() { field.buildFromParticles(scenario.positions, PARTICLE_RADIUS); },
+                           [&]() { field.applyBlur(options.blurIterations); }),
+                   scenario, "DensityField::applyBlur", voxels);
+
+            MarchingCubes marchingCubes;
+            MeshData mesh;
+            record(measure(options.reps, []() {}, [&]() { mesh = marchingCubes.generateMesh(field, 0.5f); }),
+                   scenario, "MarchingCubes", voxels);
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        writeJson(options.jsonPath, options, results);
+    }
+
+    delete engine;
+    return 0;
+}
@@ -0,0 +1,270 @@
+﻿#include "aabbTree.h"
+#include <algorithm>
+
+DynamicAABBTree::DynamicAABBTree(float margin)
+    : m_margin(margin) {
+}
+
+int DynamicAABBTree::allocateNode() {
+    if (m_freeList == NULL_NODE) {
+        m_nodes.emplace_back();
+        m_nodes.back().height = 0;
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    const int nodeId = m_freeList;
+    m_freeList = m_nodes[nodeId].parent;
+    m_nodes[nodeId] = Node{};
+    m_nodes[nodeId].height = 0;
+    return nodeId;
+}
+
+void DynamicAABBTree::freeNode(int nodeId) {
+    m_nodes[nodeId].parent = m_freeList;
+    m_nodes[nodeId].height = -1;
+    m_nodes[nodeId].userData = nullptr;
+    m_freeList = nodeId;
+}
+
+int DynamicAABBTree::createProxy(const AABB& box, void* userData) {
+    const int proxyId = allocateNode();
+    m_nodes[proxyId].box = box.expanded(m_margin);
+    m_nodes[proxyId].userData = userData;
+    insertLeaf(proxyId);
+    ++m_proxyCount;
+    return proxyId;
+}
+
+void DynamicAABBTree::destroyProxy(int proxyId) {
+    if (proxyId < 0 || proxyId >= static_cast<int>(m_nodes.size()) || !m_nodes[proxyId].isLeaf()) return;
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --m_proxyCount;
+}
+
+bool DynamicAABBTree::moveProxy(int proxyId, const AABB& box) {
+    if (m_nodes[proxyId].box.contains(box)) {
+        return false;  // 仍在胖包围盒内，无需调整树
+    }
+
+    removeLeaf(proxyId);
+    m_nodes[proxyId].box = box.expanded(m_margin);
+    insertLeaf(proxyId);
+    return true;
+}
+
+void DynamicAABBTree::insertLeaf(int leaf) {
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // 按表面积启发式向下寻找最佳兄弟节点
+    const AABB leafBox = m_nodes[leaf].box;
+    int index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node& node = m_nodes[index];
+        const float area = node.box.surfaceArea();
+        const float combinedArea = AABB::merge(node.box, leafBox).surfaceArea();
+
+        // 在此处新建父节点的代价，以及继续下降需要承担的增量代价
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](int child) {
+            const AABB merged = AABB::merge(leafBox, m_nodes[child].box);
+            if (m_nodes[child].isLeaf()) {
+                return merged.surfaceArea() + inheritanceCost;
+            }
+            return merged.surfaceArea() - m_nodes[child].box.surfaceArea() + inheritanceCost;
+        };
+        const float cost1 = childCost(node.child1);
+        const float cost2 = childCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    // 创建新的父节点
+    const int sibling = index;
+    const int oldParent = m_nodes[sibling].parent;
+    const int newParent = allocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].box = AABB::merge(leafBox, m_nodes[sibling].box);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (m_nodes[oldParent].child1 == sibling) m_nodes[oldParent].child1 = newParent;
+        else m_nodes[oldParent].child2 = newParent;
+    } else {
+        m_root = newParent;
+    }
+
+    // 向上修正包围盒与高度
+    index = m_nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+        const int child1 = m_nodes[index].child1;
+        const int child2 = m_nodes[index].child2;
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+        m_nodes[index].box = AABB::merge(m_nodes[child1].box, m_nodes[child2].box);
+        index = m_nodes[index].parent;
+    }
+}
+
+void DynamicAABBTree::removeLeaf(int leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    const int parent = m_nodes[leaf].parent;
+    const int grandParent = m_nodes[parent].parent;
+    const int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent != NULL_NODE) {
+        // 用兄弟节点替换父节点
+        if (m_nodes[grandParent].child1 == parent) m_nodes[grandParent].child1 = sibling;
+        else m_nodes[grandParent].child2 = sibling;
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        int index = grandParent;
+        while (index != NULL_NODE) {
+            index = balance(index);
+            const int child1 = m_nodes[index].child1;
+            const int child2 = m_nodes[index].child2;
+            m_nodes[index].box = AABB::merge(m_nodes[child1].box, m_nodes[child2].box);
+            m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+            index = m_nodes[index].parent;
+        }
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+    m_nodes[leaf].parent = NULL_NODE;
+}
+
+int DynamicAABBTree::balance(int iA) {
+    // 节点 A 的左右子树高度差超过 1 时做一次旋转，返回旋转后该位置的节点
+    Node& A = m_nodes[iA];
+    if (A.isLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    const int iB = A.child1;
+    const int iC = A.child2;
+    const int balanceFactor = m_nodes[iC].height - m_nodes[iB].height;
+
+    // 把较高的子节点提升到 A 的位置
+    auto rotate = [&](int iHigh, int iLow, bool highIsChild2) {
+        Node& high = m_nodes[iHigh];
+        const int iF = high.child1;
+        const int iG = high.child2;
+
+        high.child1 = iA;
+        high.parent = m_nodes[iA].parent;
+        m_nodes[iA].parent = iHigh;
+
+        if (high.parent != NULL_NODE) {
+            if (m_nodes[high.parent].child1 == iA) m_nodes[high.parent].child1 = iHigh;
+            else m_nodes[high.parent].child2 = iHigh;
+        } else {
+            m_root = iHigh;
+        }
+
+        // 较高的孙节点留在提升后的节点下，较低的孙节点交给 A
+        const bool fHigher = m_nodes[iF].height > m_nodes[iG].height;
+        const int iKeep = fHigher ? iF : iG;
+        const int iGive = fHigher ? iG : iF;
+        high.child2 = iKeep;
+        if (highIsChild2) m_nodes[iA].child2 = iGive;
+        else m_nodes[iA].child1 = iGive;
+        m_nodes[iGive].parent = iA;
+
+        m_nodes[iA].box = AABB::merge(m_nodes[iLow].box, m_nodes[iGive].box);
+        high.box = AABB::merge(m_nodes[iA].box, m_nodes[iKeep].box);
+        m_nodes[iA].height = 1 + std::max(m_nodes[iLow].height, m_nodes[iGive].height);
+        high.height = 1 + std::max(m_nodes[iA].height, m_nodes[iKeep].height);
+        return iHigh;
+    };
+
+    if (balanceFactor > 1) return rotate(iC, iB, true);
+    if (balanceFactor < -1) return rotate(iB, iC, false);
+    return iA;
+}
+
+void DynamicAABBTree::collectLeaves(int nodeId, const std::function<void(void*)>& callback) const {
+    std::vector<int> stack;
+    stack.push_back(nodeId);
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+        const Node& node = m_nodes[index];
+        if (node.isLeaf()) {
+            callback(node.userData);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicAABBTree::query(const Frustum& frustum, const std::function<void(void*)>& callback) const {
+    if (m_root == NULL_NODE) return;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+        const Node& node = m_nodes[index];
+
+        const Frustum::Result result = frustum.classify(node.box);
+        if (result == Frustum::Result::OUTSIDE) continue;
+
+        if (node.isLeaf()) {
+            callback(node.userData);
+        } else if (result == Frustum::Result::INSIDE) {
+            collectLeaves(index, callback);  // 整棵子树可见
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicAABBTree::query(const AABB& box, const std::function<void(void*)>& callback) const {
+    if (m_root == NULL_NODE) return;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+        const Node& node = m_nodes[index];
+        if (!node.box.overlaps(box)) continue;
+
+        if (node.isLeaf()) {
+            callback(node.userData);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicAABBTree::clear() {
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_proxyCount = 0;
+}
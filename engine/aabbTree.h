@@ -0,0 +1,106 @@
+﻿#ifndef AABB_TREE_H
+#define AABB_TREE_H
+
+#include "bounds.h"
+#include "frustum.h"
+#include <vector>
+#include <functional>
+
+/**
+ * @brief 动态 AABB 树（场景包围体层次）
+ *
+ * 叶节点保存对象的"胖"包围盒（实际包围盒外扩 margin）。对象移动时只要实际包围盒仍在胖包围盒内
+ * 就不修改树；超出时才移除并按表面积代价重新插入，沿途旋转保持平衡。
+ * 节点存放在连续数组中，通过空闲链表复用。
+ */
+class DynamicAABBTree {
+public:
+    static constexpr int NULL_NODE = -1;
+
+    /**
+     * @param margin 胖包围盒外扩距离
+     */
+    explicit DynamicAABBTree(float margin = 0.2f);
+
+    /**
+     * @brief 创建代理
+     * @param box 实际包围盒
+     * @param userData 用户数据（通常为 Object*）
+     * @return 代理ID
+     */
+    int createProxy(const AABB& box, void* userData);
+
+    /**
+     * @brief 销毁代理
+     */
+    void destroyProxy(int proxyId);
+
+    /**
+     * @brief 更新代理包围盒
+     * @return 是否重新插入了树（实际包围盒超出了胖包围盒）
+     */
+    bool moveProxy(int proxyId, const AABB& box);
+
+    /**
+     * @brief 获取代理的用户数据
+     */
+    void* getUserData(int proxyId) const { return m_nodes[proxyId].userData; }
+
+    /**
+     * @brief 获取代理的胖包围盒
+     */
+    const AABB& getFatAABB(int proxyId) const { return m_nodes[proxyId].box; }
+
+    /**
+     * @brief 视锥查询：对每个可见叶节点调用 callback(userData)
+     * 完全在视锥内的子树不再逐节点测试
+     */
+    void query(const Frustum& frustum, const std::function<void(void*)>& callback) const;
+
+    /**
+     * @brief 包围盒查询：对每个与 box 相交的叶节点调用 callback(userData)
+     */
+    void query(const AABB& box, const std::function<void(void*)>& callback) const;
+
+    /**
+     * @brief 清空树
+     */
+    void clear();
+
+    /**
+     * @brief 树高度（空树为 0）
+     */
+    int getHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+
+    /**
+     * @brief 代理数量
+     */
+    int getProxyCount() const { return m_proxyCount; }
+
+private:
+    struct Node {
+        AABB box;                 // 包围盒（叶节点为胖包围盒）
+        void* userData{ nullptr };
+        int parent{ NULL_NODE };  // 父节点（空闲节点时为下一个空闲节点）
+        int child1{ NULL_NODE };
+        int child2{ NULL_NODE };
+        int height{ -1 };         // 叶节点为 0，空闲节点为 -1
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    int allocateNode();
+    void freeNode(int nodeId);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int nodeId);
+    void collectLeaves(int nodeId, const std::function<void(void*)>& callback) const;
+
+    std::vector<Node> m_nodes;
+    int m_root{ NULL_NODE };
+    int m_freeList{ NULL_NODE };
+    int m_proxyCount{ 0 };
+    float m_margin;
+};
+
+#endif // AABB_TREE_H
@@ -0,0 +1,77 @@
+﻿#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+
+/**
+ * @brief 轴对齐包围盒（世界空间）
+ */
+struct AABB {
+    glm::vec3 min{ 0.0f };  // 最小角
+    glm::vec3 max{ 0.0f };  // 最大角
+
+    AABB() = default;
+    AABB(const glm::vec3& minCorner, const glm::vec3& maxCorner) : min(minCorner), max(maxCorner) {}
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extents() const { return (max - min) * 0.5f; }
+
+    /**
+     * @brief 表面积（用于 AABB 树插入代价）
+     */
+    float surfaceArea() const {
+        const glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /**
+     * @brief 是否完全包含另一个包围盒
+     */
+    bool contains(const AABB& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+               max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    /**
+     * @brief 是否与另一个包围盒相交
+     */
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    /**
+     * @brief 向各方向扩展 margin
+     */
+    AABB expanded(float margin) const {
+        return AABB(min - glm::vec3(margin), max + glm::vec3(margin));
+    }
+
+    /**
+     * @brief 两个包围盒的并集
+     */
+    static AABB merge(const AABB& a, const AABB& b) {
+        return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+
+    /**
+     * @brief 旋转后的盒子的包围盒
+     * @param center 盒子中心
+     * @param halfExtents 盒子局部半尺寸
+     * @param rotation 盒子旋转
+     */
+    static AABB fromOrientedBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::quat& rotation) {
+        const glm::mat3 r = glm::mat3_cast(rotation);
+        // 世界半尺寸 = |R| * 局部半尺寸
+        const glm::vec3 e(
+            std::abs(r[0].x) * halfExtents.x + std::abs(r[1].x) * halfExtents.y + std::abs(r[2].x) * halfExtents.z,
+            std::abs(r[0].y) * halfExtents.x + std::abs(r[1].y) * halfExtents.y + std::abs(r[2].y) * halfExtents.z,
+            std::abs(r[0].z) * halfExtents.x + std::abs(r[1].z) * halfExtents.y + std::abs(r[2].z) * halfExtents.z);
+        return AABB(center - e, center + e);
+    }
+};
+
+#endif // BOUNDS_H
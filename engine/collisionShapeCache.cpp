@@ -0,0 +1,79 @@
+﻿#include "collisionShapeCache.h"
+
+CollisionShapeCache::CollisionShapeCache(rp3d::PhysicsCommon& physicsCommon)
+    : m_physicsCommon(physicsCommon) {
+}
+
+CollisionShapeCache::~CollisionShapeCache() {
+    for (auto& [key, entry] : m_entries) {
+        destroyShape(key.type, entry.shape);
+    }
+    m_entries.clear();
+    m_shapeKeys.clear();
+}
+
+rp3d::BoxShape* CollisionShapeCache::acquireBox(const glm::vec3& halfExtents) {
+    return static_cast<rp3d::BoxShape*>(acquire({ ShapeType::BOX, { halfExtents.x, halfExtents.y, halfExtents.z } }));
+}
+
+rp3d::SphereShape* CollisionShapeCache::acquireSphere(float radius) {
+    return static_cast<rp3d::SphereShape*>(acquire({ ShapeType::SPHERE, { radius, 0.0f, 0.0f } }));
+}
+
+rp3d::CapsuleShape* CollisionShapeCache::acquireCapsule(float radius, float height) {
+    return static_cast<rp3d::CapsuleShape*>(acquire({ ShapeType::CAPSULE, { radius, height, 0.0f } }));
+}
+
+rp3d::CollisionShape* CollisionShapeCache::acquire(const Key& key) {
+    Entry& entry = m_entries[key];
+    if (!entry.shape) {
+        switch (key.type) {
+            case ShapeType::BOX:
+                entry.shape = m_physicsCommon.createBoxShape(rp3d::Vector3(key.dims[0], key.dims[1], key.dims[2]));
+                break;
+            case ShapeType::SPHERE:
+                entry.shape = m_physicsCommon.createSphereShape(key.dims[0]);
+                break;
+            case ShapeType::CAPSULE:
+                entry.shape = m_physicsCommon.createCapsuleShape(key.dims[0], key.dims[1]);
+                break;
+        }
+        m_shapeKeys.emplace(entry.shape, key);
+    }
+    ++entry.refCount;
+    return entry.shape;
+}
+
+void CollisionShapeCache::release(rp3d::CollisionShape* shape) {
+    auto keyIt = m_shapeKeys.find(shape);
+    if (keyIt == m_shapeKeys.end()) return;
+
+    auto entryIt = m_entries.find(keyIt->second);
+    if (--entryIt->second.refCount > 0) return;
+
+    destroyShape(keyIt->second.type, shape);
+    m_entries.erase(entryIt);
+    m_shapeKeys.erase(keyIt);
+}
+
+size_t CollisionShapeCache::getReferenceCount() const {
+    size_t count = 0;
+    for (const auto& [key, entry] : m_entries) {
+        count += entry.refCount;
+    }
+    return count;
+}
+
+void CollisionShapeCache::destroyShape(ShapeType type, rp3d::CollisionShape* shape) {
+    switch (type) {
+        case ShapeType::BOX:
+            m_physicsCommon.destroyBoxShape(static_cast<rp3d::BoxShape*>(shape));
+            break;
+        case ShapeType::SPHERE:
+            m_physicsCommon.destroySphereShape(static_cast<rp3d::SphereShape*>(shape));
+            break;
+        case ShapeType::CAPSULE:
+            m_physicsCommon.destroyCapsuleShape(static_cast<rp3d::CapsuleShape*>(shape));
+            break;
+    }
+}
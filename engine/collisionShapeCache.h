@@ -0,0 +1,108 @@
+﻿#ifndef COLLISION_SHAPE_CACHE_H
+#define COLLISION_SHAPE_CACHE_H
+
+#include <reactphysics3d/reactphysics3d.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+/**
+ * @brief 碰撞形状缓存
+ *
+ * 按形状类型与尺寸（按位比较）缓存 rp3d 碰撞形状，引用计数管理：
+ * 尺寸相同的对象共享同一个形状，最后一个引用释放时才交给 PhysicsCommon 销毁。
+ * 只在主线程使用（流水线物理模式下调用方已先等待物理步完成）。
+ */
+class CollisionShapeCache {
+public:
+    /**
+     * @param physicsCommon 创建/销毁形状所用的 PhysicsCommon
+     */
+    explicit CollisionShapeCache(rp3d::PhysicsCommon& physicsCommon);
+
+    /**
+     * @brief 析构时销毁仍被缓存的形状
+     */
+    ~CollisionShapeCache();
+
+    CollisionShapeCache(const CollisionShapeCache&) = delete;
+    CollisionShapeCache& operator=(const CollisionShapeCache&) = delete;
+
+    /**
+     * @brief 获取盒子形状（引用计数 +1）
+     * @param halfExtents 半尺寸
+     */
+    rp3d::BoxShape* acquireBox(const glm::vec3& halfExtents);
+
+    /**
+     * @brief 获取球体形状（引用计数 +1）
+     */
+    rp3d::SphereShape* acquireSphere(float radius);
+
+    /**
+     * @brief 获取胶囊形状（引用计数 +1）
+     */
+    rp3d::CapsuleShape* acquireCapsule(float radius, float height);
+
+    /**
+     * @brief 释放形状（引用计数 -1，归零时销毁）；不属于缓存的形状忽略
+     */
+    void release(rp3d::CollisionShape* shape);
+
+    /**
+     * @brief 缓存中的形状数量
+     */
+    size_t getShapeCount() const { return m_entries.size(); }
+
+    /**
+     * @brief 所有形状的引用总数（即共享这些形状的碰撞体数量）
+     */
+    size_t getReferenceCount() const;
+
+private:
+    enum class ShapeType : uint32_t { BOX, SPHERE, CAPSULE };
+
+    // 形状键：类型 + 最多 3 个尺寸参数
+    struct Key {
+        ShapeType type;
+        float dims[3];
+
+        bool operator==(const Key& other) const {
+            return type == other.type && std::memcmp(dims, other.dims, sizeof(dims)) == 0;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            uint32_t bits[3];
+            std::memcpy(bits, key.dims, sizeof(bits));
+            size_t h = static_cast<size_t>(key.type);
+            for (uint32_t b : bits) {
+                h ^= b + 0x9e3779b9u + (h << 6) + (h >> 2);
+            }
+            return h;
+        }
+    };
+
+    struct Entry {
+        rp3d::CollisionShape* shape{ nullptr };
+        uint32_t refCount{ 0 };
+    };
+
+    /**
+     * @brief 查找或创建形状
+     */
+    rp3d::CollisionShape* acquire(const Key& key);
+
+    /**
+     * @brief 交给 PhysicsCommon 销毁形状
+     */
+    void destroyShape(ShapeType type, rp3d::CollisionShape* shape);
+
+    rp3d::PhysicsCommon& m_physicsCommon;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;                  // 键 → 形状
+    std::unordered_map<const rp3d::CollisionShape*, Key> m_shapeKeys;  // 形状 → 键（释放时查找）
+};
+
+#endif // COLLISION_SHAPE_CACHE_H
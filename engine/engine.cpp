@@ -5,6 +5,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <chrono>
 
 //#define DEBUG
 
@@ -12,6 +13,7 @@
 
 #include "../glFrameWork/glFrameWork.h"
 #include "../wrapper/checkError.h"
+#include "../wrapper/debugOutput.h"
 
 
 #include "camera.h"
@@ -25,6 +27,13 @@
 #include "object/plane.h" // 引入Plane类
 #include "object/slime/slime.h" // 引入Slime类
 #include "scene.h" // 引入Scene类
+#include "meshCache.h" // 共享几何缓存
+#include "collisionShapeCache.h" // 共享碰撞形状缓存
+#include "profiler.h" // CPU 性能分析
+#include "frameStats.h" // 帧时间统计
+#include "inputRecorder.h" // 输入录制与回放
+#include "snapshot.h" // 场景状态快照
+#include "instanceBatcher.h" // 实例化批处理
 
 #define Ptr std::shared_ptr
 #define MPtr std::make_shared
@@ -49,7 +58,19 @@ void setAcceleration(glm::vec3& acceleration)
 
 void Engine::update()
 {
-    float deltaTime = myApp->getDeltaTime();
+    PROFILE_SCOPE("Engine::update");
+    float deltaTime = frameDeltaTime;
+    
+    if (inputRecorder->isReplaying()) {
+        // 回放：相机取自日志，不读键盘和鼠标
+        const InputRecorder::Frame& frame = inputRecorder->getReplayFrame();
+        camera->setPosition(frame.cameraPosition);
+        camera->setYaw(frame.yaw);
+        camera->setPitch(frame.pitch);
+        camera->setRoll(frame.roll);
+        playerController->update(deltaTime);
+        return;
+    }
     
     // 根据控制模式决定如何更新
     if (playerController->getControlMode() == PlayerController::ControlMode::CAMERA) {
@@ -124,6 +145,15 @@ int Engine::_initOpenGL()
 		std::cerr << "Failed to initialize application." << std::endl;
 		return -1;
 	}
+#ifdef DEBUG
+	// 驱动回调报告 GL 错误与警告，不再每次调用后 glGetError
+	// 默认只收 MEDIUM 及以上；GL_DEBUG_CONTEXT 构建（调试上下文）连同 LOW 一起报告
+#ifdef GL_DEBUG_CONTEXT
+	installDebugOutput(GL_DEBUG_SEVERITY_LOW);
+#else
+	installDebugOutput(GL_DEBUG_SEVERITY_MEDIUM);
+#endif
+#endif
 	// 设置OpenGL状态
 	GL_CALL(glEnable(GL_BLEND));
 	GL_CALL(glEnable(GL_DEPTH_TEST));
@@ -136,12 +166,17 @@ int Engine::_initOpenGL()
 	return 0;
 }
 
-Engine::Engine() {
+Engine::Engine()
+    : physicsCommon(&physicsAllocator) {
 	
 }
 
 Engine::~Engine() {
     
+    // 0. 等待快照的后台写入完成
+    delete snapshot;
+    snapshot = nullptr;
+    
     // 1. 删除玩家控制器
     delete playerController;
     playerController = nullptr;
@@ -155,16 +190,32 @@ Engine::~Engine() {
         physicsCommon.destroyPhysicsWorld(pWorld);
         pWorld = nullptr;
     }
+    delete shapeCache;
+    shapeCache = nullptr;
     
     // 4. 删除 OpenGL 相关资源
     delete vao;
     vao = nullptr;
     
+    delete meshCache;
+    meshCache = nullptr;
+    
+    delete instanceBatcher;
+    instanceBatcher = nullptr;
+    
     delete shaderManager;
     shaderManager = nullptr;
     
-    glDeleteTextures(1, &texture);
-    glDeleteTextures(1, &texture2);
+    delete frameUniformBuffer;
+    frameUniformBuffer = nullptr;
+    
+    delete gpuTimer;
+    gpuTimer = nullptr;
+    
+    if (!headless) {
+        glDeleteTextures(1, &texture);
+        glDeleteTextures(1, &texture2);
+    }
     
     // 5. 删除纹理管理器
     delete textureManager;
@@ -174,50 +225,91 @@ Engine::~Engine() {
     delete camera;
     camera = nullptr;
     
+    delete frameStats;
+    frameStats = nullptr;
+    
+    delete inputRecorder;  // 录制中则在此写入日志
+    inputRecorder = nullptr;
+    
     // 7. 最后销毁 OpenGL 上下文
-    myApp->destroy();
+    if (!headless) {
+#ifdef DEBUG
+        logDebugOutputSummary();
+#endif
+        myApp->destroy();
+    }
 }
 
 void Engine::setupDemoData()
 {
-    // 加载纹理
-    texture = textureManager->loadTexture("assets/textures/container.jpg", "container");
-    texture2 = textureManager->loadTexture("assets/textures/awesomeface.png", "awesomeface");
-    
-    // 配置 basic shader
-    auto* basicShader = shaderManager->getShader("basic");
-    basicShader->begin();
-    basicShader->setInt("texture1", 0);
-    basicShader->setInt("texture2", 1);
-    basicShader->end();
-    
-    // 配置 sphere shader
-    auto* sphereShader = shaderManager->getShader("sphere");
-    sphereShader->begin();
-    sphereShader->setInt("texture1", 0);
-    sphereShader->end();
-    
-    // 配置 slime shader
-    auto* slimeShader = shaderManager->getShader("slime");
-    slimeShader->begin();
-    slimeShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
-    slimeShader->end();
-    
-    // 配置 slime_mesh shader
-    auto* slimeMeshShader = shaderManager->getShader("slime_mesh");
-    slimeMeshShader->begin();
-    slimeMeshShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
-    slimeMeshShader->end();
-
+    // 无头模式没有纹理与着色器，对象只参与模拟
+    Shader* basicShader = nullptr;
+    Shader* sphereShader = nullptr;
+    Shader* slimeParticleShader = nullptr;
+    Shader* slimeMeshShaderPtr = nullptr;
+    Shader* slimeImpostorShader = nullptr;
+    
     // 设置相机
     camera->setFOV(60.0f);
     
-    // 初始化全局 Uniform
-    updateGlobalUniforms();
+    if (!headless) {
+        // 加载纹理
+        texture = textureManager->loadTexture("assets/textures/container.jpg", "container");
+        texture2 = textureManager->loadTexture("assets/textures/awesomeface.png", "awesomeface");
+        
+        // 配置 basic shader
+        basicShader = shaderManager->getShader("basic");
+        basicShader->begin();
+        basicShader->setInt("texture1", 0);
+        basicShader->setInt("texture2", 1);
+        basicShader->end();
+        
+        auto* basicInstancedShader = shaderManager->getShader("basic_instanced");
+        basicInstancedShader->begin();
+        basicInstancedShader->setInt("texture1", 0);
+        basicInstancedShader->setInt("texture2", 1);
+        basicInstancedShader->end();
+        
+        // 配置 sphere shader
+        sphereShader = shaderManager->getShader("sphere");
+        sphereShader->begin();
+        sphereShader->setInt("texture1", 0);
+        sphereShader->end();
+        
+        auto* sphereInstancedShader = shaderManager->getShader("sphere_instanced");
+        sphereInstancedShader->begin();
+        sphereInstancedShader->setInt("texture1", 0);
+        sphereInstancedShader->end();
+        
+        // 配置 slime shader
+        auto* slimeShader = shaderManager->getShader("slime");
+        slimeShader->begin();
+        slimeShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
+        slimeShader->end();
+        
+        // 配置 slime_mesh shader
+        auto* slimeMeshShader = shaderManager->getShader("slime_mesh");
+        slimeMeshShader->begin();
+        slimeMeshShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
+        slimeMeshShader->end();
+        
+        // 配置 slime_impostor shader
+        slimeImpostorShader = shaderManager->getShader("slime_impostor");
+        slimeImpostorShader->begin();
+        slimeImpostorShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
+        slimeImpostorShader->end();
+        
+        slimeParticleShader = slimeShader;
+        slimeMeshShaderPtr = slimeMeshShader;
+        
+        // 初始化全局 Uniform
+        updateGlobalUniforms();
+    }
     
     // 创建地板
     Plane* floor = new Plane(this, glm::vec3(0.0f, -5.0f, 0.0f), glm::vec2(50.0f, 50.0f), basicShader, texture);
     floor->setTextureRepeat(10.0f, 10.0f);
+    floor->setOccluder(true);
     floor->initPhysics(Object::PhysicsType::STATIC, Object::CollisionShape::PLANE, glm::vec3(50.0f, 0.2f, 50.0f));
     scene->addObject(floor);
     
@@ -256,8 +348,6 @@ void Engine::setupDemoData()
 
     
     // 创建史莱姆
-    auto* slimeParticleShader = shaderManager->getShader("slime");
-    auto* slimeMeshShaderPtr = shaderManager->getShader("slime_mesh");
     Slime* mySlime = new Slime(this, glm::vec3(-3.0f, 3.0f, 0.0f), 2.0f, 600, 
                                slimeParticleShader, slimeMeshShaderPtr, 0);
     
@@ -265,6 +355,7 @@ void Engine::setupDemoData()
     mySlime->setRestDensity(50.0f);         // 密度
     mySlime->setParticleRadius(0.12f);      // 粒子大小
     mySlime->setCohesionStrength(50.0f);     // 向心力
+    mySlime->setImpostorShader(slimeImpostorShader);  // 球体替身渲染（M 键循环切换）
 
 	mySlime->setName("PlayerSlime"); // 设置名称
     
@@ -279,65 +370,89 @@ void Engine::setupDemoData()
    
 }
 
-void Engine::updateGlobalUniforms() // 更新所有 Shader 的全局 Uniform
+void Engine::updateGlobalUniforms() // 更新所有 Shader 共享的全局 Uniform
 {
-    glm::mat4 viewMatrix = camera->getViewMatrix();
-    glm::mat4 projectionMatrix = camera->getProjectionMatrix();
-    
-    // 更新所有 Shader 的 View 和 Projection 矩阵
-    auto* basicShader = shaderManager->getShader("basic");
-    basicShader->begin();
-    basicShader->setMat4("uView", viewMatrix);
-    basicShader->setMat4("uProjection", projectionMatrix);
-    basicShader->end();
-    
-    auto* sphereShader = shaderManager->getShader("sphere");
-    sphereShader->begin();
-    sphereShader->setMat4("uView", viewMatrix);
-    sphereShader->setMat4("uProjection", projectionMatrix);
-    sphereShader->end();
-    
-    // 更新 slime shader (粒子模式)
-    auto* slimeShader = shaderManager->getShader("slime");
-    slimeShader->begin();
-    slimeShader->setMat4("uView", viewMatrix);
-    slimeShader->setMat4("uProjection", projectionMatrix);
-    slimeShader->set("uCameraPos", camera->getPosition());
-    slimeShader->setFloat("uTime", static_cast<float>(glfwGetTime()));
-    slimeShader->end();
-    
-    // 更新 slime_mesh shader (网格模式)
-    auto* slimeMeshShader = shaderManager->getShader("slime_mesh");
-    slimeMeshShader->begin();
-    slimeMeshShader->setMat4("uView", viewMatrix);
-    slimeMeshShader->setMat4("uProjection", projectionMatrix);
-    slimeMeshShader->set("uCameraPos", camera->getPosition());
-    slimeMeshShader->setFloat("uTime", static_cast<float>(glfwGetTime()));
-    slimeMeshShader->end();
+    FrameUniforms frame;
+    frame.view = camera->getViewMatrix();
+    frame.projection = camera->getProjectionMatrix();
+    frame.cameraPos = camera->getPosition();
+    frame.time = static_cast<float>(glfwGetTime());
+    
+    // 一次上传，所有声明了 FrameUniforms 块的 Shader 同时生效
+    frameUniformBuffer->update(frame);
 }
 
 void Engine::render()
 {
+    using Clock = std::chrono::steady_clock;
+    auto toMs = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    Clock::time_point lastFrameStart = Clock::now();
+    
+    // GPU 结果落后几帧读回，按帧号补填到对应样本；没有读回的帧保持 -1
+    const uint64_t gpuFrameOffset = frameStats->getTotalFrames() - gpuTimer->getFrameIndex();
+    gpuTimer->setFrameCallback([this, gpuFrameOffset](uint64_t frame, double ms) {
+        frameStats->setGpuMs(frame + gpuFrameOffset, ms);
+    });
+    
     while (myApp->update()) {
-		this->update();
+        const Clock::time_point frameStart = Clock::now();
+        FrameStats::Sample sample;
         
-        // 每帧更新全局 Uniform
-        updateGlobalUniforms();
+        frameDeltaTime = static_cast<float>(myApp->getDeltaTime());
+        if (inputRecorder->isReplaying()) {
+            if (!inputRecorder->nextReplayFrame()) {
+                // 日志播完：结束运行
+                glfwSetWindowShouldClose(myApp->getWindow(), GLFW_TRUE);
+                continue;
+            }
+            // 使用录制时的步长，并重放本帧的按键
+            const InputRecorder::Frame& frame = inputRecorder->getReplayFrame();
+            frameDeltaTime = frame.deltaTime;
+            inputRecorder->setDispatching(true);
+            for (const InputRecorder::KeyEvent& event : frame.keys) {
+                keyCallback(event.key, GLFW_PRESS, event.mods);
+            }
+            inputRecorder->setDispatching(false);
+        }
         
-        GL_CALL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+        gpuTimer->beginFrame();
+        {
+            PROFILE_SCOPE("Engine::render");
+            this->update();
+            
+            // 每帧更新全局 Uniform
+            updateGlobalUniforms();
+            
+            {
+                GPU_TIMER_SCOPE(gpuTimer, "clear");
+                GL_CALL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+            }
+            
+            // 更新并渲染场景
+            const float deltaTime = frameDeltaTime;
+            const Clock::time_point simStart = Clock::now();
+            scene->update(deltaTime);
+            sample.simMs = toMs(Clock::now() - simStart);
+            scene->render();
+            
+            // 定期清理非活跃对象
+            static float cleanupTimer = 0.0f;
+            cleanupTimer += deltaTime;
+            if (cleanupTimer >= 5.0f) {  // 每5秒清理一次
+                scene->cleanupInactiveObjects();
+                cleanupTimer = 0.0f;
+            }
+        }
         
-        // 更新并渲染场景
-        float deltaTime = myApp->getDeltaTime();
-        scene->update(deltaTime);
-        scene->render();
+        // 汇总本帧各线程的分析区段
+        Profiler::instance().endFrame();
+        gpuTimer->endFrame();
+        inputRecorder->endFrame(frameDeltaTime, *camera);
         
-        // 定期清理非活跃对象
-        static float cleanupTimer = 0.0f;
-        cleanupTimer += deltaTime;
-        if (cleanupTimer >= 5.0f) {  // 每5秒清理一次
-            scene->cleanupInactiveObjects();
-            cleanupTimer = 0.0f;
-        }
+        sample.cpuMs = toMs(Clock::now() - frameStart);
+        sample.frameMs = toMs(frameStart - lastFrameStart);
+        lastFrameStart = frameStart;
+        frameStats->record(sample);
     }
 }
 
@@ -358,6 +473,12 @@ void Engine::keyCallback(int key, int action, int mods)
     auto& cameraData = self->cameraData;
     
     if (action != GLFW_PRESS) return;
+    
+    // 回放期间忽略实时按键；录制时记下按键，回放时在同一帧重放
+    InputRecorder* recorder = self->inputRecorder;
+    if (recorder->isReplaying() && !recorder->isDispatching()) return;
+    recorder->recordKey(key, mods);
+    
     switch (key)
     {
         case GLFW_KEY_LEFT_ALT:
@@ -389,9 +510,77 @@ void Engine::keyCallback(int key, int action, int mods)
             break;
         }
         
+        case GLFW_KEY_O:
+        {
+            // 按 O 键切换 CPU 遮挡剔除
+            bool enabled = !self->scene->isOcclusionCullingEnabled();
+            self->scene->setOcclusionCullingEnabled(enabled);
+            std::cout << "[Engine] 遮挡剔除：" << (enabled ? "开启" : "关闭") << std::endl;
+            break;
+        }
+        
+        case GLFW_KEY_P:
+        {
+            // 按 P 键切换流水线物理（物理步在工作线程上与渲染重叠）
+            bool enabled = !self->scene->isPhysicsPipelined();
+            self->scene->setPhysicsPipelined(enabled);
+            std::cout << "[Engine] 流水线物理：" << (enabled ? "开启" : "关闭") << std::endl;
+            break;
+        }
+        
+        case GLFW_KEY_F2:
+        {
+            // 按 F2 键开关分析报告（每 120 帧打印一次平均耗时；关闭时分析器不计时）
+            Profiler& profiler = Profiler::instance();
+            profiler.setReportInterval(profiler.getReportInterval() > 0 ? 0 : 120);
+            std::cout << "[Engine] 性能分析报告：" << (profiler.getReportInterval() > 0 ? "开启" : "关闭") << std::endl;
+            break;
+        }
+        
+        case GLFW_KEY_F3:
+        {
+            // 按 F3 键录制 120 帧时间线（Chrome trace JSON，可用 Perfetto 打开）
+            Profiler& profiler = Profiler::instance();
+            if (!profiler.isCapturing()) {
+                profiler.beginCapture(120, "profile_trace.json");
+            }
+            break;
+        }
+        
+        case GLFW_KEY_F4:
+        {
+            // 按 F4 键打印缓冲内全部帧的汇总并导出 CSV，同时打印最近的 GPU 分段耗时
+            self->frameStats->logSummary(self->frameStats->getSampleCount());
+            self->frameStats->writeCsv("frame_stats.csv");
+            self->gpuTimer->logLastFrame();
+            break;
+        }
+        
+        case GLFW_KEY_F5:
+        {
+            // 按 F5 键保存场景快照（后台写入 snapshot.bin）
+            self->snapshot->save("snapshot.bin");
+            break;
+        }
+        
+        case GLFW_KEY_F6:
+        {
+            // 按 F6 键恢复 snapshot.bin（对象变换、刚体速度与史莱姆粒子）
+            self->snapshot->load("snapshot.bin");
+            break;
+        }
+        
+        case GLFW_KEY_K:
+        {
+            // 按 K 键打印各子系统内存统计
+            MemorySystem::instance().updateRates();
+            MemorySystem::instance().logStats();
+            break;
+        }
+        
         case GLFW_KEY_M:
         {
-            // 按 M 键切换渲染模式（粒子/网格）
+            // 按 M 键切换渲染模式（粒子/替身/网格）
             Slime* slime = dynamic_cast<Slime*>(self->playerController->getControlledObject());
             if (slime) {
                 slime->toggleRenderMode();
@@ -402,20 +591,34 @@ void Engine::keyCallback(int key, int action, int mods)
 
 }int Engine::init() {
 	myApp->engine = this;
+    Profiler::instance().setThreadName("Main");
     this->_initOpenGL();
     textureManager = new TextureManager();
     shaderManager = new ShaderManager();
+    frameUniformBuffer = new UniformBuffer<FrameUniforms>(FRAME_UNIFORMS_BINDING);
+    gpuTimer = new GpuTimer();
+    shaderManager->setUniformBlockBinding("FrameUniforms", FRAME_UNIFORMS_BINDING);
     camera = new Camera(glm::vec3(-2.0f, -3.0f, 3.0f), glm::vec3(-2.0f, -4.0f, 0.0f));
     camera->enableFPS(true);
     shaderManager->loadShader("basic", "assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl");
     shaderManager->loadShader("sphere", "assets/shaders/sphere_vertex.glsl", "assets/shaders/sphere_fragment.glsl");
     shaderManager->loadShader("slime", "assets/shaders/slime_vertex.glsl", "assets/shaders/slime_fragment.glsl");
     shaderManager->loadShader("slime_mesh", "assets/shaders/slime_mesh_vertex.glsl", "assets/shaders/slime_mesh_fragment.glsl");
+    shaderManager->loadShader("slime_impostor", "assets/shaders/slime_impostor_vertex.glsl", "assets/shaders/slime_impostor_fragment.glsl");
+    shaderManager->loadShader("basic_instanced", "assets/shaders/vertex_instanced.glsl", "assets/shaders/fragment.glsl");
+    shaderManager->loadShader("sphere_instanced", "assets/shaders/sphere_instanced_vertex.glsl", "assets/shaders/sphere_fragment.glsl");
+
+    // 共享几何与实例化批处理
+    instanceBatcher = new InstanceBatcher();
+    instanceBatcher->registerInstancedShader(shaderManager->getShader("basic"), shaderManager->getShader("basic_instanced"));
+    instanceBatcher->registerInstancedShader(shaderManager->getShader("sphere"), shaderManager->getShader("sphere_instanced"));
+    meshCache = new MeshCache(instanceBatcher);
 
 	myApp->setKeyboardCallback(keyCallback);
 
     // 初始化物理引擎
     this->pWorld = this->physicsCommon.createPhysicsWorld();
+    shapeCache = new CollisionShapeCache(physicsCommon);
     
     // 设置重力
     this->pWorld->setGravity(rp3d::Vector3(0.0f, -9.81f, 0.0f));
@@ -425,7 +628,29 @@ void Engine::keyCallback(int key, int action, int mods)
     
     //  创建玩家控制器
     playerController = new PlayerController(this, camera);
+    
+    frameStats = new FrameStats();
+    inputRecorder = new InputRecorder();
+    snapshot = new Snapshot(this);
 
 
+    return 0;
+}
+
+int Engine::initHeadless() {
+    // 不创建窗口与 GL 上下文：纹理、着色器、实例化批处理和几何缓存都保持为空
+    headless = true;
+    Profiler::instance().setThreadName("Main");
+    camera = new Camera(glm::vec3(-2.0f, -3.0f, 3.0f), glm::vec3(-2.0f, -4.0f, 0.0f));
+    
+    this->pWorld = this->physicsCommon.createPhysicsWorld();
+    shapeCache = new CollisionShapeCache(physicsCommon);
+    this->pWorld->setGravity(rp3d::Vector3(0.0f, -9.81f, 0.0f));
+    
+    scene = new Scene(this);
+    playerController = new PlayerController(this, camera);
+    frameStats = new FrameStats();
+    snapshot = new Snapshot(this);
+    
     return 0;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../application/application.h"
 
 #include "reactphysics3d/reactphysics3d.h"
+#include "memoryAllocator.h"
 
 class Camera;
 class TextureManager;
@@ -16,19 +17,49 @@ class Sphere; // 前向声明
 class Plane; // 前向声明
 class Scene; // 前向声明
 class PlayerController; // 前向声明
+class MeshCache; // 前向声明
+class InstanceBatcher; // 前向声明
+class CollisionShapeCache; // 前向声明
+class FrameStats; // 前向声明
+class InputRecorder; // 前向声明
+class Snapshot; // 前向声明
+
+/**
+ * @brief 每帧共享的全局 Uniform（std140 布局，对应着色器中的 FrameUniforms 块）
+ */
+struct FrameUniforms {
+    glm::mat4 view;        // uView
+    glm::mat4 projection;  // uProjection
+    glm::vec3 cameraPos;   // uCameraPos
+    float time;            // uTime（与 cameraPos 共用一个 16 字节槽）
+};
+static_assert(sizeof(FrameUniforms) == 144, "FrameUniforms must match the std140 block layout");
 
 class Engine {
 public:
+	PhysicsMemoryAllocator physicsAllocator;  // rp3d 基础分配器（PHYSICS 标签池），须先于 physicsCommon 构造
 	rp3d::PhysicsCommon physicsCommon;
 	rp3d::PhysicsWorld* pWorld{nullptr};
+	CollisionShapeCache* shapeCache{nullptr};  // 共享碰撞形状缓存
 
 public:
 	ShaderManager* shaderManager{nullptr};
+	UniformBuffer<FrameUniforms>* frameUniformBuffer{nullptr};  // 全局 Uniform 缓冲
+	static constexpr GLuint FRAME_UNIFORMS_BINDING = 0;         // FrameUniforms 块绑定点
+	InstanceBatcher* instanceBatcher{nullptr};  // 实例化批处理器
+	MeshCache* meshCache{nullptr};              // 共享几何缓存
 	Scene* scene{nullptr};  // 场景管理器
 	PlayerController* playerController{nullptr};  // 玩家控制器
+	FrameStats* frameStats{nullptr};  // 帧时间统计
+	GpuTimer* gpuTimer{nullptr};      // GPU 分段计时（无头模式为空）
+	InputRecorder* inputRecorder{nullptr};  // 输入录制与回放（无头模式为空）
+	Snapshot* snapshot{nullptr};            // 场景状态快照（检查点与恢复）
 
 public:
 	bool mouseCaptured{ false };
+	bool headless{ false };  // 无窗口、无 GL 上下文（基准测试），对象跳过 GPU 资源
+	uint32_t randomSeed{ 0 };  // 场景初始化的随机种子（0 表示每次随机；录制/回放时固定）
+	float frameDeltaTime{ 0.0f };  // 本帧时间步长（实时或回放日志中的值）
 
 public: // 相机控制
 	struct CameraData {
@@ -57,13 +88,18 @@ public:
 	* @return 状态值
 	*/
 	int init();
+	/**
+	* @brief 无头初始化：只创建物理世界、场景与相机，不创建窗口和 GL 上下文
+	* @return 状态值
+	*/
+	int initHeadless();
 
     void update();
     void render();
     void setupDemoData();
     
     /**
-     * @brief 更新所有 Shader 的全局 Uniform（View、Projection 矩阵）
+     * @brief 更新全局 Uniform 缓冲（View、Projection、相机位置、时间），所有 Shader 共享
      */
     void updateGlobalUniforms();
 
@@ -71,7 +107,7 @@ public:
     // 保留用于兼容性
     std::vector<float> vertices;
     std::vector<unsigned int> indices;
-    VAO* vao;
+    VAO* vao{nullptr};
 
 public:
 	TextureManager* textureManager{nullptr};
@@ -0,0 +1,120 @@
+﻿#include "frameStats.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    double valueOf(const FrameStats::Sample& sample, FrameStats::Metric metric) {
+        switch (metric) {
+            case FrameStats::Metric::FRAME: return sample.frameMs;
+            case FrameStats::Metric::CPU:   return sample.cpuMs;
+            case FrameStats::Metric::SIM:   return sample.simMs;
+            case FrameStats::Metric::GPU:   return sample.gpuMs;
+        }
+        return 0.0;
+    }
+}
+
+double FrameStats::percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const size_t rank = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void FrameStats::record(const Sample& sample) {
+    m_samples[m_head] = sample;
+    m_head = (m_head + 1) % CAPACITY;
+    m_count = std::min(m_count + 1, CAPACITY);
+    ++m_totalFrames;
+
+    if (m_logInterval > 0 && ++m_framesSinceLog >= m_logInterval) {
+        logSummary(static_cast<size_t>(m_logInterval));
+        m_framesSinceLog = 0;
+    }
+}
+
+void FrameStats::setGpuMs(uint64_t frame, double ms) {
+    if (frame >= m_totalFrames) return;
+    const uint64_t age = m_totalFrames - 1 - frame;
+    if (age >= m_count) return;
+    m_samples[(m_head + CAPACITY - 1 - age) % CAPACITY].gpuMs = ms;
+}
+
+const FrameStats::Sample& FrameStats::at(size_t age) const {
+    return m_samples[(m_head + CAPACITY - 1 - age) % CAPACITY];
+}
+
+const FrameStats::Sample& FrameStats::getLastSample() const {
+    return at(0);
+}
+
+FrameStats::Summary FrameStats::summarize(Metric metric, size_t windowFrames) const {
+    if (windowFrames == 0) windowFrames = m_logInterval > 0 ? m_logInterval : m_count;
+    const size_t frames = std::min(windowFrames, m_count);
+
+    std::vector<double> values;
+    values.reserve(frames);
+    for (size_t age = 0; age < frames; ++age) {
+        const double value = valueOf(at(age), metric);
+        if (value >= 0.0) values.push_back(value);  // GPU 样本可能缺失
+    }
+
+    Summary summary;
+    if (values.empty()) return summary;
+
+    double total = 0.0;
+    for (double value : values) total += value;
+    std::sort(values.begin(), values.end());
+
+    summary.frames = values.size();
+    summary.mean = total / values.size();
+    summary.p50 = percentile(values, 0.50);
+    summary.p95 = percentile(values, 0.95);
+    summary.p99 = percentile(values, 0.99);
+    summary.max = values.back();
+
+    const double hitchThreshold = summary.p50 * m_hitchFactor;
+    summary.hitches = static_cast<uint32_t>(values.end() - std::upper_bound(values.begin(), values.end(), hitchThreshold));
+    return summary;
+}
+
+void FrameStats::logSummary(size_t windowFrames) const {
+    auto print = [](const char* label, const Summary& s) {
+        std::cout << " | " << label << " p50 " << s.p50 << " p95 " << s.p95 << " p99 " << s.p99 << " max " << s.max;
+    };
+
+    const Summary frame = summarize(Metric::FRAME, windowFrames);
+    const Summary gpu = summarize(Metric::GPU, windowFrames);
+    const std::ios::fmtflags flags = std::cout.flags();
+    const std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(2) << "[FrameStats] " << frame.frames << " 帧 (ms)";
+    print("frame", frame);
+    print("cpu", summarize(Metric::CPU, windowFrames));
+    print("sim", summarize(Metric::SIM, windowFrames));
+    if (gpu.frames > 0) print("gpu", gpu);
+    std::cout << " | 卡顿 " << frame.hitches << std::endl;
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
+
+bool FrameStats::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "[FrameStats] 无法写入 " << path << std::endl;
+        return false;
+    }
+
+    out << "frame,frame_ms,cpu_ms,sim_ms,gpu_ms\n";
+    out << std::fixed << std::setprecision(4);
+    const uint64_t firstFrame = m_totalFrames - m_count;
+    for (size_t i = 0; i < m_count; ++i) {
+        const Sample& sample = at(m_count - 1 - i);
+        out << firstFrame + i << ',' << sample.frameMs << ',' << sample.cpuMs << ',' << sample.simMs << ',';
+        if (sample.gpuMs >= 0.0) out << sample.gpuMs;
+        out << '\n';
+    }
+
+    std::cout << "[FrameStats] 已导出 " << m_count << " 帧 -> " << path << std::endl;
+    return true;
+}
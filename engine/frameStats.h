@@ -0,0 +1,105 @@
+﻿#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 帧时间统计
+ *
+ * 每帧记录一个样本（帧间隔、CPU 帧耗时、模拟耗时、GPU 耗时）到固定容量的环形缓冲，
+ * 按最近 N 帧的滑动窗口计算 p50/p95/p99/max 与卡顿次数（超过窗口中位数 hitchFactor 倍的帧）。
+ * 设置了日志间隔时每隔若干帧打印一行汇总；writeCsv() 导出缓冲中的全部样本。
+ */
+class FrameStats {
+public:
+    static constexpr size_t CAPACITY = 1 << 14;  // 环形缓冲样本数
+
+    /**
+     * @brief 一帧的计时（毫秒），gpuMs < 0 表示不可用
+     */
+    struct Sample {
+        double frameMs{ 0.0 };   // 与上一帧开始的间隔（含交换缓冲与事件处理）
+        double cpuMs{ 0.0 };     // 主线程帧循环体耗时
+        double simMs{ 0.0 };     // Scene::update 耗时
+        double gpuMs{ -1.0 };    // GPU 耗时（读回后由 setGpuMs 补填，未读回或被丢弃的帧保持 -1）
+    };
+
+    enum class Metric { FRAME, CPU, SIM, GPU };
+
+    /**
+     * @brief 某个指标在窗口内的统计
+     */
+    struct Summary {
+        size_t frames{ 0 };      // 参与统计的帧数（GPU 只计有效样本）
+        double mean{ 0.0 };
+        double p50{ 0.0 };
+        double p95{ 0.0 };
+        double p99{ 0.0 };
+        double max{ 0.0 };
+        uint32_t hitches{ 0 };   // 超过 hitchFactor * p50 的帧数
+    };
+
+    /**
+     * @brief 记录一帧
+     */
+    void record(const Sample& sample);
+
+    /**
+     * @brief 补填第 frame 帧（从 0 起，与 getTotalFrames 同一计数）的 GPU 耗时；该帧已移出缓冲或尚未记录时忽略
+     */
+    void setGpuMs(uint64_t frame, double ms);
+
+    /**
+     * @brief 计算最近 windowFrames 帧的统计（0 表示使用日志窗口）
+     */
+    Summary summarize(Metric metric, size_t windowFrames = 0) const;
+
+    /**
+     * @brief 最近一帧的样本
+     */
+    const Sample& getLastSample() const;
+    size_t getSampleCount() const { return m_count; }
+    uint64_t getTotalFrames() const { return m_totalFrames; }
+
+    /**
+     * @brief 每隔 frames 帧打印一行最近 frames 帧的汇总（0 关闭）
+     */
+    void setLogInterval(int frames) { m_logInterval = frames; m_framesSinceLog = 0; }
+    int getLogInterval() const { return m_logInterval; }
+
+    void setHitchFactor(double factor) { m_hitchFactor = factor; }
+    double getHitchFactor() const { return m_hitchFactor; }
+
+    /**
+     * @brief 打印最近 windowFrames 帧的汇总
+     */
+    void logSummary(size_t windowFrames) const;
+
+    /**
+     * @brief 把缓冲中的全部样本写成 CSV（frame,frame_ms,cpu_ms,sim_ms,gpu_ms）
+     * @return 是否写入成功
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /**
+     * @brief 最近秩分位数（sorted 须已升序排列，为空时返回 0）
+     */
+    static double percentile(const std::vector<double>& sorted, double p);
+
+private:
+    const Sample& at(size_t age) const;  // age = 0 为最近一帧
+
+    std::vector<Sample> m_samples = std::vector<Sample>(CAPACITY);
+    size_t m_head{ 0 };          // 下一个写入位置
+    size_t m_count{ 0 };         // 有效样本数
+    uint64_t m_totalFrames{ 0 };
+
+    int m_logInterval{ 600 };
+    int m_framesSinceLog{ 0 };
+    double m_hitchFactor{ 2.0 };
+};
+
+#endif // FRAME_STATS_H
@@ -0,0 +1,81 @@
+﻿#include "frustum.h"
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FRUSTUM_USE_SSE 1
+#include <xmmintrin.h>
+#endif
+
+Frustum::Frustum() {
+    // 补齐平面恒为 0*p + 1 >= 0，任何包围盒都在其内侧
+    for (int i = 0; i < PADDED_PLANE_COUNT; ++i) {
+        m_nx[i] = 0.0f;
+        m_ny[i] = 0.0f;
+        m_nz[i] = 0.0f;
+        m_d[i] = 1.0f;
+    }
+}
+
+void Frustum::update(const glm::mat4& m) {
+    // Gribb-Hartmann 平面提取（glm 列主序：m[col][row]）
+    glm::vec4 planes[PLANE_COUNT];
+    for (int i = 0; i < 4; ++i) {
+        planes[0][i] = m[i][3] + m[i][0];  // 左
+        planes[1][i] = m[i][3] - m[i][0];  // 右
+        planes[2][i] = m[i][3] + m[i][1];  // 下
+        planes[3][i] = m[i][3] - m[i][1];  // 上
+        planes[4][i] = m[i][3] + m[i][2];  // 近
+        planes[5][i] = m[i][3] - m[i][2];  // 远
+    }
+
+    for (int i = 0; i < PLANE_COUNT; ++i) {
+        const float length = glm::length(glm::vec3(planes[i]));
+        const glm::vec4 p = length > 0.0f ? planes[i] / length : planes[i];
+        m_nx[i] = p.x;
+        m_ny[i] = p.y;
+        m_nz[i] = p.z;
+        m_d[i] = p.w;
+    }
+}
+
+Frustum::Result Frustum::classify(const AABB& box) const {
+    const glm::vec3 c = box.center();
+    const glm::vec3 e = box.extents();
+
+#ifdef FRUSTUM_USE_SSE
+    // 每次测试 4 个平面：dist = n·c + d，r = |n|·e
+    // dist < -r 则完全在该平面外；所有平面 dist >= r 则完全在内
+    const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+    const __m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ez = _mm_set1_ps(e.z);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    int intersectMask = 0;
+    for (int i = 0; i < PADDED_PLANE_COUNT; i += 4) {
+        const __m128 nx = _mm_load_ps(m_nx + i);
+        const __m128 ny = _mm_load_ps(m_ny + i);
+        const __m128 nz = _mm_load_ps(m_nz + i);
+        const __m128 d = _mm_load_ps(m_d + i);
+
+        const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                                       _mm_add_ps(_mm_mul_ps(nz, cz), d));
+        const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, nx), ex),
+                                                    _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey)),
+                                         _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), radius))) != 0) {
+            return Result::OUTSIDE;
+        }
+        intersectMask |= _mm_movemask_ps(_mm_cmplt_ps(dist, radius));
+    }
+    return intersectMask != 0 ? Result::INTERSECT : Result::INSIDE;
+#else
+    bool intersect = false;
+    for (int i = 0; i < PLANE_COUNT; ++i) {
+        const float dist = m_nx[i] * c.x + m_ny[i] * c.y + m_nz[i] * c.z + m_d[i];
+        const float radius = std::abs(m_nx[i]) * e.x + std::abs(m_ny[i]) * e.y + std::abs(m_nz[i]) * e.z;
+        if (dist < -radius) return Result::OUTSIDE;
+        if (dist < radius) intersect = true;
+    }
+    return intersect ? Result::INTERSECT : Result::INSIDE;
+#endif
+}
@@ -0,0 +1,53 @@
+﻿#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "bounds.h"
+#include <glm/glm.hpp>
+
+/**
+ * @brief 视锥体，用于包围盒可见性测试
+ *
+ * 从 projection * view 矩阵提取 6 个平面（法线指向视锥内部），以 SoA 形式存放并补齐到 8 个，
+ * 包围盒测试一次处理 4 个平面（SSE），不支持 SSE 的平台回退到标量实现。
+ */
+class Frustum {
+public:
+    /**
+     * @brief 测试结果
+     */
+    enum class Result {
+        OUTSIDE,    // 完全在视锥外
+        INTERSECT,  // 与视锥边界相交
+        INSIDE      // 完全在视锥内
+    };
+
+    Frustum();
+
+    /**
+     * @brief 从矩阵提取视锥平面
+     * @param viewProjection projection * view
+     */
+    void update(const glm::mat4& viewProjection);
+
+    /**
+     * @brief 分类包围盒与视锥的关系
+     */
+    Result classify(const AABB& box) const;
+
+    /**
+     * @brief 包围盒是否可见（在视锥内或相交）
+     */
+    bool isVisible(const AABB& box) const { return classify(box) != Result::OUTSIDE; }
+
+private:
+    static constexpr int PLANE_COUNT = 6;
+    static constexpr int PADDED_PLANE_COUNT = 8;  // 补齐到 SIMD 宽度的倍数
+
+    // 平面 SoA：n.x * x + n.y * y + n.z * z + d >= 0 表示在内侧
+    alignas(16) float m_nx[PADDED_PLANE_COUNT];
+    alignas(16) float m_ny[PADDED_PLANE_COUNT];
+    alignas(16) float m_nz[PADDED_PLANE_COUNT];
+    alignas(16) float m_d[PADDED_PLANE_COUNT];
+};
+
+#endif // FRUSTUM_H
@@ -0,0 +1,176 @@
+﻿#include "inputRecorder.h"
+#include "camera.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char MAGIC[4] = { 'G', 'S', 'I', 'R' };
+    constexpr size_t HEADER_SIZE = 16;
+    constexpr uint8_t FLAG_PLAYER_FORCE = 1;
+}
+
+InputRecorder::~InputRecorder() {
+    stop();
+}
+
+template<typename T>
+void InputRecorder::write(const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+bool InputRecorder::read(T& value) {
+    if (m_readOffset + sizeof(T) > m_buffer.size()) return false;
+    std::memcpy(&value, m_buffer.data() + m_readOffset, sizeof(T));
+    m_readOffset += sizeof(T);
+    return true;
+}
+
+bool InputRecorder::startRecording(const std::string& path, uint32_t seed) {
+    stop();
+    m_path = path;
+    m_seed = seed;
+    m_buffer.clear();
+    m_buffer.reserve(1 << 20);
+    m_frameIndex = 0;
+    m_frameCount = 0;
+    m_frame = Frame{};
+
+    // 帧数在停止时回填
+    m_buffer.insert(m_buffer.end(), MAGIC, MAGIC + 4);
+    write(FORMAT_VERSION);
+    write(seed);
+    write(uint32_t{ 0 });
+
+    m_mode = Mode::RECORDING;
+    std::cout << "[InputRecorder] 开始录制 -> " << path << " | 种子 " << seed << std::endl;
+    return true;
+}
+
+bool InputRecorder::startReplay(const std::string& path) {
+    stop();
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cout << "[InputRecorder] 无法打开 " << path << std::endl;
+        return false;
+    }
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    uint32_t version = 0, frameCount = 0;
+    m_readOffset = 4;
+    if (m_buffer.size() < HEADER_SIZE || std::memcmp(m_buffer.data(), MAGIC, 4) != 0 ||
+        !read(version) || version != FORMAT_VERSION || !read(m_seed) || !read(frameCount)) {
+        std::cout << "[InputRecorder] 不是有效的输入日志（或版本不符）：" << path << std::endl;
+        m_buffer.clear();
+        return false;
+    }
+
+    m_path = path;
+    m_frameCount = frameCount;
+    m_frameIndex = 0;
+    m_mode = Mode::REPLAYING;
+    std::cout << "[InputRecorder] 开始回放 " << path << " | " << frameCount << " 帧 | 种子 " << m_seed << std::endl;
+    return true;
+}
+
+void InputRecorder::stop() {
+    if (m_mode == Mode::RECORDING) {
+        flush();
+    } else if (m_mode == Mode::REPLAYING) {
+        std::cout << "[InputRecorder] 回放结束：" << m_frameIndex << "/" << m_frameCount << " 帧" << std::endl;
+    }
+    m_mode = Mode::IDLE;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_readOffset = 0;
+    m_dispatching = false;
+}
+
+bool InputRecorder::flush() {
+    const uint32_t frameCount = static_cast<uint32_t>(m_frameCount);
+    std::memcpy(m_buffer.data() + 12, &frameCount, sizeof(frameCount));
+
+    std::ofstream out(m_path, std::ios::binary);
+    if (!out) {
+        std::cout << "[InputRecorder] 无法写入 " << m_path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+    std::cout << "[InputRecorder] 已写入 " << m_frameCount << " 帧（" << m_buffer.size() << " 字节） -> " << m_path << std::endl;
+    return static_cast<bool>(out);
+}
+
+void InputRecorder::recordKey(int key, int mods) {
+    if (m_mode != Mode::RECORDING) return;
+    m_frame.keys.push_back(KeyEvent{ static_cast<uint16_t>(key), static_cast<uint8_t>(mods) });
+}
+
+void InputRecorder::recordPlayerForce(const glm::vec3& force) {
+    if (m_mode != Mode::RECORDING) return;
+    m_frame.hasPlayerForce = true;
+    m_frame.playerForce += force;
+}
+
+void InputRecorder::endFrame(float deltaTime, const Camera& camera) {
+    if (m_mode != Mode::RECORDING) return;
+
+    const glm::vec3 position = camera.getPosition();
+    write(deltaTime);
+    write(position.x);
+    write(position.y);
+    write(position.z);
+    write(camera.getYaw());
+    write(camera.getPitch());
+    write(camera.getRoll());
+    write(static_cast<uint8_t>(m_frame.hasPlayerForce ? FLAG_PLAYER_FORCE : 0));
+    if (m_frame.hasPlayerForce) {
+        write(m_frame.playerForce.x);
+        write(m_frame.playerForce.y);
+        write(m_frame.playerForce.z);
+    }
+    const size_t keyCount = std::min<size_t>(m_frame.keys.size(), 255);
+    write(static_cast<uint8_t>(keyCount));
+    for (size_t i = 0; i < keyCount; ++i) {
+        write(m_frame.keys[i].key);
+        write(m_frame.keys[i].mods);
+    }
+
+    ++m_frameCount;
+    m_frame.hasPlayerForce = false;
+    m_frame.playerForce = glm::vec3(0.0f);
+    m_frame.keys.clear();
+}
+
+bool InputRecorder::nextReplayFrame() {
+    if (m_mode != Mode::REPLAYING) return false;
+
+    Frame frame;
+    uint8_t flags = 0, keyCount = 0;
+    bool ok = m_frameIndex < m_frameCount &&
+              read(frame.deltaTime) &&
+              read(frame.cameraPosition.x) && read(frame.cameraPosition.y) && read(frame.cameraPosition.z) &&
+              read(frame.yaw) && read(frame.pitch) && read(frame.roll) &&
+              read(flags);
+    if (ok && (flags & FLAG_PLAYER_FORCE)) {
+        frame.hasPlayerForce = true;
+        ok = read(frame.playerForce.x) && read(frame.playerForce.y) && read(frame.playerForce.z);
+    }
+    ok = ok && read(keyCount);
+    for (uint8_t i = 0; ok && i < keyCount; ++i) {
+        KeyEvent event{};
+        ok = read(event.key) && read(event.mods);
+        frame.keys.push_back(event);
+    }
+
+    if (!ok) {
+        stop();
+        return false;
+    }
+    m_frame = std::move(frame);
+    ++m_frameIndex;
+    return true;
+}
@@ -0,0 +1,113 @@
+﻿#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Camera;
+
+/**
+ * @brief 模拟输入的录制与回放
+ *
+ * 录制：每帧记下 deltaTime、按键事件（Engine::keyCallback 收到的按下）、玩家控制器施加的力
+ * 和帧末的相机变换，编码为紧凑的二进制帧追加到内存缓冲，停止时写入文件。
+ * 回放：启动时把整个日志读入内存，每帧取出一帧，由 Engine 用它代替实时输入
+ * （不读键盘与鼠标），配合 Scene 的固定物理步长即可在不同机器、不同构建上复现同一负载。
+ * 文件头记录随机种子，回放前交给引擎，使史莱姆粒子的初始分布一致。
+ *
+ * 格式（小端）：头 "GSIR" | u32 版本 | u32 种子 | u32 帧数；
+ * 每帧 f32 dt | f32×3 相机位置 | f32 yaw, pitch, roll | u8 标志 | [f32×3 力] | u8 按键数 | {u16 键, u8 修饰键}×n
+ */
+class InputRecorder {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    enum class Mode { IDLE, RECORDING, REPLAYING };
+
+    struct KeyEvent {
+        uint16_t key;
+        uint8_t mods;
+    };
+
+    struct Frame {
+        float deltaTime{ 0.0f };
+        glm::vec3 cameraPosition{ 0.0f };
+        float yaw{ 0.0f };
+        float pitch{ 0.0f };
+        float roll{ 0.0f };
+        bool hasPlayerForce{ false };
+        glm::vec3 playerForce{ 0.0f };
+        std::vector<KeyEvent> keys;
+    };
+
+    ~InputRecorder();
+
+    /**
+     * @brief 开始录制到 path（停止或析构时写入）
+     */
+    bool startRecording(const std::string& path, uint32_t seed);
+
+    /**
+     * @brief 读入 path 的全部帧并开始回放
+     */
+    bool startReplay(const std::string& path);
+
+    /**
+     * @brief 停止录制（写文件）或回放
+     */
+    void stop();
+
+    Mode getMode() const { return m_mode; }
+    bool isRecording() const { return m_mode == Mode::RECORDING; }
+    bool isReplaying() const { return m_mode == Mode::REPLAYING; }
+    uint32_t getSeed() const { return m_seed; }
+    size_t getFrameIndex() const { return m_frameIndex; }
+    size_t getFrameCount() const { return m_frameCount; }
+
+    // ===== 录制 =====
+    void recordKey(int key, int mods);
+    void recordPlayerForce(const glm::vec3& force);
+
+    /**
+     * @brief 结束一帧：写入 deltaTime、相机变换与本帧收集的按键和力
+     */
+    void endFrame(float deltaTime, const Camera& camera);
+
+    // ===== 回放 =====
+    /**
+     * @brief 解码下一帧
+     * @return 日志已播完时返回 false（并停止回放）
+     */
+    bool nextReplayFrame();
+    const Frame& getReplayFrame() const { return m_frame; }
+
+    /**
+     * @brief 回放的按键正在分发给 Engine::keyCallback（区分实时按键）
+     */
+    void setDispatching(bool dispatching) { m_dispatching = dispatching; }
+    bool isDispatching() const { return m_dispatching; }
+
+private:
+    template<typename T>
+    void write(const T& value);
+    template<typename T>
+    bool read(T& value);
+
+    bool flush();
+
+    Mode m_mode{ Mode::IDLE };
+    std::string m_path;
+    uint32_t m_seed{ 0 };
+
+    std::vector<uint8_t> m_buffer;   // 录制时为编码后的帧，回放时为整个文件
+    size_t m_readOffset{ 0 };
+    size_t m_frameIndex{ 0 };
+    size_t m_frameCount{ 0 };
+
+    Frame m_frame;                   // 录制中的当前帧 / 回放的当前帧
+    bool m_dispatching{ false };
+};
+
+#endif // INPUT_RECORDER_H
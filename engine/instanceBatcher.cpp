@@ -0,0 +1,41 @@
+﻿#include "instanceBatcher.h"
+
+InstanceBatcher::InstanceBatcher(size_t capacity) {
+    m_instanceBuffer = std::make_shared<StreamingBuffer<glm::mat4>>(capacity);
+}
+
+void InstanceBatcher::registerInstancedShader(Shader* shader, Shader* instancedShader) {
+    if (shader && instancedShader) {
+        m_instancedShaders[shader] = instancedShader;
+    }
+}
+
+Shader* InstanceBatcher::getInstancedShader(Shader* shader) const {
+    auto it = m_instancedShaders.find(shader);
+    return it != m_instancedShaders.end() ? it->second : nullptr;
+}
+
+void InstanceBatcher::attachInstanceAttributes(VAO& vao) {
+    // mat4 占用 4 个连续的 vec4 属性
+    vao.addInstancedVBO(*m_instanceBuffer, "4f 4f 4f 4f", INSTANCE_MATRIX_LOCATION);
+}
+
+void InstanceBatcher::begin() {
+    m_writePtr = m_instanceBuffer->beginWrite();
+    m_used = 0;
+}
+
+glm::mat4* InstanceBatcher::allocate(size_t count, GLuint& firstInstance) {
+    if (!m_writePtr || m_used + count > m_instanceBuffer->capacity()) {
+        return nullptr;
+    }
+    firstInstance = static_cast<GLuint>(m_used);
+    glm::mat4* ptr = m_writePtr + m_used;
+    m_used += count;
+    return ptr;
+}
+
+void InstanceBatcher::end() {
+    m_instanceBuffer->endWrite();
+    m_writePtr = nullptr;
+}
@@ -0,0 +1,89 @@
+﻿#ifndef INSTANCE_BATCHER_H
+#define INSTANCE_BATCHER_H
+
+#include "../glFrameWork/core.h"
+#include "../glFrameWork/buffers.h"
+#include "../glFrameWork/shader.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @brief 实例化批处理器
+ *
+ * 持有每帧的实例模型矩阵流式缓冲，并登记普通 Shader 到其实例化变体的映射。
+ * 渲染队列把网格与材质完全相同的连续绘制包合并为一次 drawInstanced，
+ * 模型矩阵写入本帧区域，通过 baseInstance 定位各批次。
+ * 实例化变体的顶点着色器从 location 4~7 读取 mat4 aInstanceModel 代替 uModel。
+ */
+class InstanceBatcher {
+public:
+    static constexpr GLuint INSTANCE_MATRIX_LOCATION = 4;  // 实例矩阵起始属性位置（占 4 个）
+    static constexpr size_t DEFAULT_CAPACITY = 16384;      // 每帧最多实例数
+    static constexpr size_t MIN_BATCH_SIZE = 2;            // 少于该数量的批次直接普通绘制
+
+    /**
+     * @brief 构造函数，分配实例矩阵流式缓冲
+     * @param capacity 每帧最多实例数
+     */
+    explicit InstanceBatcher(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief 登记 Shader 的实例化变体
+     * @param shader 普通 Shader（使用 uModel）
+     * @param instancedShader 实例化 Shader（使用 aInstanceModel）
+     */
+    void registerInstancedShader(Shader* shader, Shader* instancedShader);
+
+    /**
+     * @brief 获取 Shader 的实例化变体
+     * @return 实例化 Shader，未登记时返回 nullptr
+     */
+    Shader* getInstancedShader(Shader* shader) const;
+
+    /**
+     * @brief 为 VAO 挂接实例矩阵属性（指向本批处理器的流式缓冲）
+     */
+    void attachInstanceAttributes(VAO& vao);
+
+    /**
+     * @brief 开始一帧的实例写入
+     */
+    void begin();
+
+    /**
+     * @brief 追加一批实例的写入空间
+     * @param count 实例数
+     * @param firstInstance 输出：该批在本帧区域内的起始实例
+     * @return 可写入 count 个矩阵的指针，容量不足时返回 nullptr
+     */
+    glm::mat4* allocate(size_t count, GLuint& firstInstance);
+
+    /**
+     * @brief 结束写入，本帧区域成为绘制区域
+     */
+    void end();
+
+    /**
+     * @brief 绘制区域的起始实例（与 allocate 返回的 firstInstance 相加即为 baseInstance）
+     */
+    GLuint drawOffset() const { return m_instanceBuffer->drawOffset(); }
+
+    /**
+     * @brief 提交完读取本帧区域的绘制后调用
+     */
+    void fence() { m_instanceBuffer->fence(); }
+
+    /**
+     * @brief 本帧已写入的实例数
+     */
+    size_t instanceCount() const { return m_used; }
+
+private:
+    std::shared_ptr<StreamingBuffer<glm::mat4>> m_instanceBuffer;  // 实例矩阵流式缓冲
+    std::unordered_map<Shader*, Shader*> m_instancedShaders;       // 普通 Shader → 实例化变体
+    glm::mat4* m_writePtr{ nullptr };                              // 本帧写区域
+    size_t m_used{ 0 };                                            // 本帧已用实例数
+};
+
+#endif // INSTANCE_BATCHER_H
@@ -0,0 +1,322 @@
+﻿#include "memoryAllocator.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+const std::array<uint32_t, MemorySystem::NUM_SIZE_CLASSES> MemorySystem::SIZE_CLASSES = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+};
+
+const char* memoryTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::GENERAL: return "general";
+        case MemoryTag::PHYSICS: return "physics";
+        case MemoryTag::SCENE:   return "scene";
+        case MemoryTag::SLIME:   return "slime";
+        case MemoryTag::MESHING: return "meshing";
+        default:                 return "unknown";
+    }
+}
+
+MemorySystem& MemorySystem::instance() {
+    // 有意不析构：线程池线程的线程缓存可能在静态对象析构之后才归还内存
+    static MemorySystem* system = new MemorySystem();
+    return *system;
+}
+
+namespace {
+    thread_local bool t_threadCacheDestroyed = false;  // 平凡类型，缓存析构后仍可安全读取
+
+    // 只由所属线程写入的计数器：读取后存回，不产生跨线程争用的原子读改写
+    template<typename T>
+    void bumpOwned(std::atomic<T>& counter, T amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+size_t MemorySystem::sizeClassIndex(size_t size) {
+    return static_cast<size_t>(std::lower_bound(SIZE_CLASSES.begin(), SIZE_CLASSES.end(), size) - SIZE_CLASSES.begin());
+}
+
+MemorySystem::ThreadCache* MemorySystem::threadCache() {
+    if (t_threadCacheDestroyed) return nullptr;
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+MemorySystem::ThreadCache::ThreadCache() {
+    MemorySystem& system = MemorySystem::instance();
+    std::lock_guard<std::mutex> lock(system.m_threadCacheMutex);
+    system.m_threadCaches.push_back(this);
+}
+
+MemorySystem::ThreadCache::~ThreadCache() {
+    // 线程退出时把缓存的空闲块还给全局池，之后该线程直接使用全局池
+    t_threadCacheDestroyed = true;
+    MemorySystem& system = MemorySystem::instance();
+    for (size_t tag = 0; tag < NUM_TAGS; ++tag) {
+        for (size_t c = 0; c < NUM_SIZE_CLASSES; ++c) {
+            system.flush(system.m_tags[tag], c, heads[tag][c], counts[tag][c], 0);
+        }
+    }
+
+    // 计数并入全局后注销（同一把锁内完成，汇总时不会重复或遗漏）
+    std::lock_guard<std::mutex> lock(system.m_threadCacheMutex);
+    for (size_t tag = 0; tag < NUM_TAGS; ++tag) {
+        TagState& state = system.m_tags[tag];
+        const ThreadCounters& c = counters[tag];
+        state.allocations.fetch_add(c.allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        state.deallocations.fetch_add(c.deallocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        state.allocatedBytesTotal.fetch_add(c.allocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        state.liveBytes.fetch_add(c.pendingLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    auto& caches = system.m_threadCaches;
+    caches.erase(std::find(caches.begin(), caches.end(), this));
+}
+
+void* MemorySystem::allocate(MemoryTag tag, size_t size) {
+    TagState& state = m_tags[static_cast<size_t>(tag)];
+    ThreadCache* cache = threadCache();
+    recordAllocation(state, cache, tag, size);
+
+    if (size > MAX_SMALL_SIZE) {
+        return ::operator new(size);
+    }
+
+    const size_t classIndex = sizeClassIndex(std::max<size_t>(size, 1));
+    FreeBlock* localHead = nullptr;
+    uint32_t localCount = 0;
+    FreeBlock*& head = cache ? cache->heads[static_cast<size_t>(tag)][classIndex] : localHead;
+    uint32_t& count = cache ? cache->counts[static_cast<size_t>(tag)][classIndex] : localCount;
+    if (!head) {
+        refill(state, classIndex, head, count);
+    }
+
+    FreeBlock* block = head;
+    head = block->next;
+    --count;
+    if (!cache) {
+        flush(state, classIndex, head, count, 0);
+    }
+    return block;
+}
+
+void MemorySystem::deallocate(MemoryTag tag, void* pointer, size_t size) {
+    if (!pointer) return;
+    TagState& state = m_tags[static_cast<size_t>(tag)];
+    ThreadCache* cache = threadCache();
+    recordDeallocation(state, cache, tag, size);
+
+    if (size > MAX_SMALL_SIZE) {
+        ::operator delete(pointer);
+        return;
+    }
+
+    const size_t classIndex = sizeClassIndex(std::max<size_t>(size, 1));
+    FreeBlock* localHead = nullptr;
+    uint32_t localCount = 0;
+    FreeBlock*& head = cache ? cache->heads[static_cast<size_t>(tag)][classIndex] : localHead;
+    uint32_t& count = cache ? cache->counts[static_cast<size_t>(tag)][classIndex] : localCount;
+
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    block->next = head;
+    head = block;
+    // 缓存过多时归还一半给全局池，避免空闲块滞留在某个线程
+    if (++count > THREAD_CACHE_BATCH * 2 || !cache) {
+        flush(state, classIndex, head, count, cache ? THREAD_CACHE_BATCH : 0);
+    }
+}
+
+void MemorySystem::recordAllocation(TagState& state, ThreadCache* cache, MemoryTag tag, size_t size) {
+    if (!cache) {
+        state.allocations.fetch_add(1, std::memory_order_relaxed);
+        state.allocatedBytesTotal.fetch_add(size, std::memory_order_relaxed);
+        addLiveBytes(state, tag, static_cast<int64_t>(size));
+        return;
+    }
+
+    ThreadCounters& c = cache->counters[static_cast<size_t>(tag)];
+    bumpOwned<uint64_t>(c.allocations, 1);
+    bumpOwned<uint64_t>(c.allocatedBytes, size);
+    const int64_t pending = c.pendingLiveBytes.load(std::memory_order_relaxed) + static_cast<int64_t>(size);
+    if (pending >= LIVE_BYTES_BATCH) {
+        addLiveBytes(state, tag, pending);
+        c.pendingLiveBytes.store(0, std::memory_order_relaxed);
+    } else {
+        c.pendingLiveBytes.store(pending, std::memory_order_relaxed);
+    }
+}
+
+void MemorySystem::recordDeallocation(TagState& state, ThreadCache* cache, MemoryTag tag, size_t size) {
+    if (!cache) {
+        state.deallocations.fetch_add(1, std::memory_order_relaxed);
+        state.liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        return;
+    }
+
+    ThreadCounters& c = cache->counters[static_cast<size_t>(tag)];
+    bumpOwned<uint64_t>(c.deallocations, 1);
+    const int64_t pending = c.pendingLiveBytes.load(std::memory_order_relaxed) - static_cast<int64_t>(size);
+    if (pending <= -LIVE_BYTES_BATCH) {
+        addLiveBytes(state, tag, pending);
+        c.pendingLiveBytes.store(0, std::memory_order_relaxed);
+    } else {
+        c.pendingLiveBytes.store(pending, std::memory_order_relaxed);
+    }
+}
+
+void MemorySystem::addLiveBytes(TagState& state, MemoryTag tag, int64_t delta) {
+    const int64_t live = state.liveBytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+    if (delta <= 0 || live <= 0) return;
+
+    size_t peak = state.peakBytes.load(std::memory_order_relaxed);
+    while (static_cast<size_t>(live) > peak &&
+           !state.peakBytes.compare_exchange_weak(peak, static_cast<size_t>(live), std::memory_order_relaxed)) {}
+
+    const size_t budget = state.budgetBytes.load(std::memory_order_relaxed);
+    if (budget > 0 && static_cast<size_t>(live) > budget) {
+        state.overBudget.fetch_add(1, std::memory_order_relaxed);
+        if (!state.budgetWarned.exchange(true, std::memory_order_relaxed)) {
+            std::cout << "[MemorySystem] " << memoryTagName(tag) << " 超出预算："
+                      << live << " / " << budget << " 字节" << std::endl;
+        }
+    }
+}
+
+void MemorySystem::refill(TagState& state, size_t classIndex, FreeBlock*& head, uint32_t& count) {
+    SizeClassPool& pool = state.pools[classIndex];
+    {
+        // 先从全局空闲链表取一批
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        while (pool.freeList && count < THREAD_CACHE_BATCH) {
+            FreeBlock* block = pool.freeList;
+            pool.freeList = block->next;
+            --pool.freeCount;
+            block->next = head;
+            head = block;
+            ++count;
+        }
+    }
+    if (head) return;
+
+    // 全局池也空了：申请新内存块切分
+    const size_t blockSize = SIZE_CLASSES[classIndex];
+    const size_t chunkSize = std::max(CHUNK_SIZE, blockSize * THREAD_CACHE_BATCH);
+    char* chunk = static_cast<char*>(::operator new(chunkSize));
+    {
+        std::lock_guard<std::mutex> lock(state.chunkMutex);
+        state.chunks.push_back(chunk);
+    }
+    state.reservedBytes.fetch_add(chunkSize, std::memory_order_relaxed);
+
+    const size_t blockCount = chunkSize / blockSize;
+    for (size_t i = blockCount; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+        block->next = head;
+        head = block;
+    }
+    count += static_cast<uint32_t>(blockCount);
+
+    // 多出的块留给其他线程
+    if (count > THREAD_CACHE_BATCH * 2) {
+        flush(state, classIndex, head, count, THREAD_CACHE_BATCH);
+    }
+}
+
+void MemorySystem::flush(TagState& state, size_t classIndex, FreeBlock*& head, uint32_t& count, uint32_t keep) {
+    if (count <= keep) return;
+
+    // 摘下多余的块组成一段链表，一次加锁挂回全局池
+    FreeBlock* first = head;
+    FreeBlock* last = head;
+    uint32_t moved = 1;
+    while (count - moved > keep) {
+        last = last->next;
+        ++moved;
+    }
+    head = last->next;
+    count -= moved;
+
+    SizeClassPool& pool = state.pools[classIndex];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    last->next = pool.freeList;
+    pool.freeList = first;
+    pool.freeCount += moved;
+}
+
+void MemorySystem::setBudget(MemoryTag tag, size_t bytes) {
+    TagState& state = m_tags[static_cast<size_t>(tag)];
+    state.budgetBytes.store(bytes, std::memory_order_relaxed);
+    state.budgetWarned.store(false, std::memory_order_relaxed);
+}
+
+MemorySystem::CounterTotals MemorySystem::sumCounters(MemoryTag tag) const {
+    const size_t index = static_cast<size_t>(tag);
+    const TagState& state = m_tags[index];
+    CounterTotals totals;
+    std::lock_guard<std::mutex> lock(m_threadCacheMutex);
+    totals.allocations = state.allocations.load(std::memory_order_relaxed);
+    totals.deallocations = state.deallocations.load(std::memory_order_relaxed);
+    totals.allocatedBytes = state.allocatedBytesTotal.load(std::memory_order_relaxed);
+    totals.liveBytes = state.liveBytes.load(std::memory_order_relaxed);
+    for (const ThreadCache* cache : m_threadCaches) {
+        const ThreadCounters& c = cache->counters[index];
+        totals.allocations += c.allocations.load(std::memory_order_relaxed);
+        totals.deallocations += c.deallocations.load(std::memory_order_relaxed);
+        totals.allocatedBytes += c.allocatedBytes.load(std::memory_order_relaxed);
+        totals.liveBytes += c.pendingLiveBytes.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+MemorySystem::TagStats MemorySystem::getStats(MemoryTag tag) const {
+    const TagState& state = m_tags[static_cast<size_t>(tag)];
+    const CounterTotals totals = sumCounters(tag);
+    TagStats stats;
+    stats.liveBytes = static_cast<size_t>(std::max<int64_t>(totals.liveBytes, 0));
+    stats.peakBytes = std::max(state.peakBytes.load(std::memory_order_relaxed), stats.liveBytes);
+    stats.budgetBytes = state.budgetBytes.load(std::memory_order_relaxed);
+    stats.reservedBytes = state.reservedBytes.load(std::memory_order_relaxed);
+    stats.allocations = totals.allocations;
+    stats.deallocations = totals.deallocations;
+    stats.overBudget = state.overBudget.load(std::memory_order_relaxed);
+    stats.allocationsPerSecond = state.allocationsPerSecond;
+    stats.bytesPerSecond = state.bytesPerSecond;
+    return stats;
+}
+
+void MemorySystem::updateRates() {
+    const auto now = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(now - m_lastRateUpdate).count();
+    if (seconds <= 0.0) return;
+    m_lastRateUpdate = now;
+
+    for (size_t i = 0; i < NUM_TAGS; ++i) {
+        TagState& state = m_tags[i];
+        const CounterTotals totals = sumCounters(static_cast<MemoryTag>(i));
+        const uint64_t allocations = totals.allocations;
+        const uint64_t bytes = totals.allocatedBytes;
+        state.allocationsPerSecond = (allocations - state.lastAllocations) / seconds;
+        state.bytesPerSecond = (bytes - state.lastBytesTotal) / seconds;
+        state.lastAllocations = allocations;
+        state.lastBytesTotal = bytes;
+    }
+}
+
+void MemorySystem::logStats() const {
+    std::cout << "[MemorySystem] 标签      存活(KB)    峰值(KB)    池(KB)   分配/秒     KB/秒" << std::endl;
+    for (size_t i = 0; i < NUM_TAGS; ++i) {
+        const TagStats stats = getStats(static_cast<MemoryTag>(i));
+        std::cout << "[MemorySystem] " << std::left << std::setw(8) << memoryTagName(static_cast<MemoryTag>(i)) << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << stats.liveBytes / 1024.0
+                  << std::setw(12) << stats.peakBytes / 1024.0
+                  << std::setw(10) << stats.reservedBytes / 1024.0
+                  << std::setw(10) << stats.allocationsPerSecond
+                  << std::setw(10) << stats.bytesPerSecond / 1024.0;
+        if (stats.budgetBytes > 0) {
+            std::cout << "  预算 " << stats.budgetBytes / 1024 << " KB，超出 " << stats.overBudget << " 次";
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,238 @@
+﻿#ifndef MEMORY_ALLOCATOR_H
+#define MEMORY_ALLOCATOR_H
+
+#include <reactphysics3d/reactphysics3d.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 内存子系统标签，每个标签拥有独立的池与统计
+ */
+enum class MemoryTag : uint8_t {
+    GENERAL,   // 未归类
+    PHYSICS,   // ReactPhysics3D
+    SCENE,     // 场景对象
+    SLIME,     // 史莱姆粒子模拟
+    MESHING,   // 密度场 / 连通域 / 网格生成
+    COUNT
+};
+
+/**
+ * @brief 标签名称（用于日志）
+ */
+const char* memoryTagName(MemoryTag tag);
+
+/**
+ * @brief 引擎内存系统：按标签分池的分级（size-class）分配器
+ *
+ * - 不超过 MAX_SMALL_SIZE 的请求向上取整到尺寸级别，从该标签该级别的空闲链表分配；
+ *   每个线程有自己的空闲块缓存，批量与全局池交换，各线程、各子系统之间几乎没有锁竞争。
+ * - 更大的请求直接走全局 new，只计入统计。
+ * - 每个标签统计存活字节、峰值、分配/释放次数与分配速率，可设置预算（超出时告警，不会失败）。
+ *   计数记在各线程缓存里（只由所属线程写入），读取统计时汇总；存活字节的增量每累计 LIVE_BYTES_BATCH
+ *   才并入全局计数，峰值与预算按全局计数检查，误差不超过 线程数 × LIVE_BYTES_BATCH。
+ * 释放时必须给出与分配时相同的标签和大小。
+ */
+class MemorySystem {
+public:
+    static constexpr size_t MAX_SMALL_SIZE = 4096;  // 走池分配的最大请求
+    static constexpr size_t ALIGNMENT = 16;         // 所有块按 16 字节对齐（rp3d 的要求）
+
+    /**
+     * @brief 单个标签的统计快照
+     */
+    struct TagStats {
+        size_t liveBytes{ 0 };             // 存活字节（按请求大小）
+        size_t peakBytes{ 0 };             // 峰值存活字节
+        size_t budgetBytes{ 0 };           // 预算（0 表示不限制）
+        size_t reservedBytes{ 0 };         // 池从系统申请的字节（含空闲块）
+        uint64_t allocations{ 0 };         // 累计分配次数
+        uint64_t deallocations{ 0 };       // 累计释放次数
+        uint64_t overBudget{ 0 };          // 超出预算的分配次数
+        double allocationsPerSecond{ 0.0 };  // 最近一次 updateRates 区间的分配速率
+        double bytesPerSecond{ 0.0 };        // 同上，按字节
+    };
+
+    /**
+     * @brief 全局实例
+     */
+    static MemorySystem& instance();
+
+    /**
+     * @brief 分配内存
+     * @param tag 子系统标签
+     * @param size 字节数
+     */
+    void* allocate(MemoryTag tag, size_t size);
+
+    /**
+     * @brief 释放内存（标签与大小必须与分配时一致）
+     */
+    void deallocate(MemoryTag tag, void* pointer, size_t size);
+
+    /**
+     * @brief 设置标签预算（字节，0 表示不限制）
+     */
+    void setBudget(MemoryTag tag, size_t bytes);
+
+    /**
+     * @brief 获取标签统计
+     */
+    TagStats getStats(MemoryTag tag) const;
+
+    /**
+     * @brief 以自上次调用以来的计数计算各标签分配速率
+     */
+    void updateRates();
+
+    /**
+     * @brief 打印各标签统计
+     */
+    void logStats() const;
+
+private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;  // 池每次向系统申请的字节
+    static constexpr uint32_t THREAD_CACHE_BATCH = 32;  // 线程缓存与全局池每次交换的块数
+    static constexpr int64_t LIVE_BYTES_BATCH = 64 * 1024;  // 线程本地存活字节增量并入全局计数的阈值
+    static constexpr size_t NUM_SIZE_CLASSES = 16;
+    static constexpr size_t NUM_TAGS = static_cast<size_t>(MemoryTag::COUNT);
+    static const std::array<uint32_t, NUM_SIZE_CLASSES> SIZE_CLASSES;
+
+    // 空闲块（块的前 8 字节存放链表指针）
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // 某个标签某个尺寸级别的全局池
+    struct SizeClassPool {
+        std::mutex mutex;
+        FreeBlock* freeList{ nullptr };
+        uint32_t freeCount{ 0 };
+    };
+
+    struct TagState {
+        std::array<SizeClassPool, NUM_SIZE_CLASSES> pools;
+        std::mutex chunkMutex;
+        std::vector<void*> chunks;            // 池申请的内存块（进程生命周期内不归还）
+        std::atomic<int64_t> liveBytes{ 0 };  // 已并入的存活字节（线程本地增量另计）
+        std::atomic<size_t> peakBytes{ 0 };
+        std::atomic<size_t> budgetBytes{ 0 };
+        std::atomic<size_t> reservedBytes{ 0 };
+        // 已退出线程的计数，以及线程缓存析构后直接计入的分配
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> deallocations{ 0 };
+        std::atomic<uint64_t> allocatedBytesTotal{ 0 };
+        std::atomic<uint64_t> overBudget{ 0 };
+        std::atomic<bool> budgetWarned{ false };
+
+        // 速率统计（只在 updateRates 中读写）
+        uint64_t lastAllocations{ 0 };
+        uint64_t lastBytesTotal{ 0 };
+        double allocationsPerSecond{ 0.0 };
+        double bytesPerSecond{ 0.0 };
+    };
+
+    // 线程本地计数：只由所属线程写入（普通读改写，无原子读改写），统计时由其他线程读取
+    struct ThreadCounters {
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> deallocations{ 0 };
+        std::atomic<uint64_t> allocatedBytes{ 0 };
+        std::atomic<int64_t> pendingLiveBytes{ 0 };  // 尚未并入 TagState::liveBytes 的增量
+    };
+
+    // 线程本地缓存：每个标签每个级别一条空闲链表，以及每个标签的计数
+    struct ThreadCache {
+        FreeBlock* heads[NUM_TAGS][NUM_SIZE_CLASSES]{};
+        uint32_t counts[NUM_TAGS][NUM_SIZE_CLASSES]{};
+        ThreadCounters counters[NUM_TAGS];
+        ThreadCache();
+        ~ThreadCache();
+    };
+
+    // 各标签所有线程计数之和
+    struct CounterTotals {
+        uint64_t allocations{ 0 };
+        uint64_t deallocations{ 0 };
+        uint64_t allocatedBytes{ 0 };
+        int64_t liveBytes{ 0 };
+    };
+
+    MemorySystem() = default;
+    ~MemorySystem() = default;
+    MemorySystem(const MemorySystem&) = delete;
+    MemorySystem& operator=(const MemorySystem&) = delete;
+
+    static size_t sizeClassIndex(size_t size);
+    static ThreadCache* threadCache();  // 线程退出、缓存已析构后返回 nullptr
+
+    void recordAllocation(TagState& state, ThreadCache* cache, MemoryTag tag, size_t size);
+    void recordDeallocation(TagState& state, ThreadCache* cache, MemoryTag tag, size_t size);
+    void addLiveBytes(TagState& state, MemoryTag tag, int64_t delta);
+    CounterTotals sumCounters(MemoryTag tag) const;
+    void refill(TagState& state, size_t classIndex, FreeBlock*& head, uint32_t& count);
+    void flush(TagState& state, size_t classIndex, FreeBlock*& head, uint32_t& count, uint32_t keep);
+
+    std::array<TagState, NUM_TAGS> m_tags;
+    mutable std::mutex m_threadCacheMutex;
+    std::vector<ThreadCache*> m_threadCaches;  // 存活线程的缓存（汇总计数用）
+    std::chrono::steady_clock::time_point m_lastRateUpdate{ std::chrono::steady_clock::now() };
+};
+
+/**
+ * @brief ReactPhysics3D 基础分配器适配：PhysicsCommon 的所有内存经 PHYSICS 标签分配
+ */
+class PhysicsMemoryAllocator : public rp3d::MemoryAllocator {
+public:
+    void* allocate(size_t size) override {
+        return MemorySystem::instance().allocate(MemoryTag::PHYSICS, size);
+    }
+    void release(void* pointer, size_t size) override {
+        MemorySystem::instance().deallocate(MemoryTag::PHYSICS, pointer, size);
+    }
+};
+
+/**
+ * @brief 按标签分配的 STL 分配器
+ */
+template<typename T, MemoryTag Tag>
+class TaggedStdAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = TaggedStdAllocator<U, Tag>; };
+
+    TaggedStdAllocator() noexcept = default;
+    template<typename U>
+    TaggedStdAllocator(const TaggedStdAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= MemorySystem::ALIGNMENT, "over-aligned types are not supported");
+        return static_cast<T*>(MemorySystem::instance().allocate(Tag, n * sizeof(T)));
+    }
+    void deallocate(T* pointer, size_t n) noexcept {
+        MemorySystem::instance().deallocate(Tag, pointer, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const TaggedStdAllocator<U, Tag>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const TaggedStdAllocator<U, Tag>&) const noexcept { return false; }
+};
+
+template<MemoryTag Tag, typename T>
+using TaggedVector = std::vector<T, TaggedStdAllocator<T, Tag>>;
+
+template<MemoryTag Tag, typename K, typename V>
+using TaggedUnorderedMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>,
+                                              TaggedStdAllocator<std::pair<const K, V>, Tag>>;
+
+#endif // MEMORY_ALLOCATOR_H
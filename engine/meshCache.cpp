@@ -0,0 +1,97 @@
+﻿#include "meshCache.h"
+#include "instanceBatcher.h"
+#include "../wrapper/widgets.h"
+#include <vector>
+
+MeshCache::MeshCache(InstanceBatcher* batcher)
+    : m_batcher(batcher) {
+}
+
+std::shared_ptr<MeshCache::Mesh> MeshCache::getOrCreate(const std::string& key, const std::function<std::shared_ptr<Mesh>()>& factory) {
+    auto it = m_meshes.find(key);
+    if (it != m_meshes.end()) {
+        return it->second;
+    }
+
+    std::shared_ptr<Mesh> mesh = factory();
+    if (m_batcher && mesh && mesh->vao) {
+        m_batcher->attachInstanceAttributes(*mesh->vao);
+    }
+    m_meshes[key] = mesh;
+    return mesh;
+}
+
+std::shared_ptr<MeshCache::Mesh> MeshCache::getCube() {
+    return getOrCreate("cube", []() {
+        std::vector<float> vertices = {
+            -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
+             0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
+             0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+             0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+            -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
+            -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
+
+            -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+             0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+             0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
+             0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
+            -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
+            -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+
+            -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+            -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+            -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+            -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+            -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+            -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+
+             0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+             0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+             0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+             0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+             0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+             0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+
+            -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+             0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
+             0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+             0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+            -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+            -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+
+            -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
+             0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+             0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+             0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+            -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
+            -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
+        };
+
+        auto mesh = std::make_shared<Mesh>();
+        mesh->vbo = std::make_shared<Buffer<float>>(vertices, GL_ARRAY_BUFFER, GL_STATIC_DRAW);
+        mesh->vao = new VAO();
+        mesh->vao->addVBO(*mesh->vbo, "3f 2f", GL_FALSE);
+        return mesh;
+    });
+}
+
+std::shared_ptr<MeshCache::Mesh> MeshCache::getSphere(int sectors, int stacks) {
+    const std::string key = "sphere:" + std::to_string(sectors) + "x" + std::to_string(stacks);
+    return getOrCreate(key, [sectors, stacks]() {
+        widgets::SphereData data = widgets::createSphere(1.0f, sectors, stacks);
+
+        auto mesh = std::make_shared<Mesh>();
+        mesh->vbo = std::make_shared<Buffer<float>>(data.vertices, GL_ARRAY_BUFFER, GL_STATIC_DRAW);
+        mesh->ebo = std::make_shared<Buffer<unsigned int>>(data.indices, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
+        mesh->vao = new VAO();
+        // 3f (pos) + 3f (normal) + 2f (tex)
+        mesh->vao->addVBO(*mesh->vbo, "3f 3f 2f", GL_FALSE);
+        mesh->vao->addEBO(*mesh->ebo);
+        mesh->indexCount = static_cast<GLsizei>(data.indices.size());
+        return mesh;
+    });
+}
+
+void MeshCache::clear() {
+    m_meshes.clear();
+}
@@ -0,0 +1,74 @@
+﻿#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include "../glFrameWork/core.h"
+#include "../glFrameWork/buffers.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <functional>
+
+class InstanceBatcher;
+
+/**
+ * @brief 共享几何缓存
+ *
+ * 按网格类型和参数（如 "cube"、"sphere:36x18"）缓存 GPU 网格，相同几何的对象共享同一份 VBO/EBO/VAO。
+ * 网格统一按单位尺寸生成，对象尺寸通过模型矩阵缩放。
+ * 新建的 VAO 会挂接实例化批处理器的实例矩阵属性，使同一网格可直接用于实例化绘制。
+ */
+class MeshCache {
+public:
+    /**
+     * @brief 共享网格
+     */
+    struct Mesh {
+        std::shared_ptr<Buffer<float>> vbo;         // 顶点缓冲
+        std::shared_ptr<Buffer<unsigned int>> ebo;  // 索引缓冲（可为空）
+        VAO* vao{ nullptr };                        // 顶点数组
+        GLsizei indexCount{ 0 };                    // 索引数量（无 EBO 时为 0）
+
+        ~Mesh() { delete vao; }
+    };
+
+    /**
+     * @brief 构造函数
+     * @param batcher 实例化批处理器（为空时不挂接实例属性）
+     */
+    explicit MeshCache(InstanceBatcher* batcher = nullptr);
+
+    /**
+     * @brief 获取单位立方体（位置 3f + 纹理坐标 2f，36 顶点）
+     */
+    std::shared_ptr<Mesh> getCube();
+
+    /**
+     * @brief 获取单位半径球体（位置 3f + 法线 3f + 纹理坐标 2f）
+     * @param sectors 经度方向切片数
+     * @param stacks 纬度方向堆叠数
+     */
+    std::shared_ptr<Mesh> getSphere(int sectors, int stacks);
+
+    /**
+     * @brief 按键获取网格，不存在时调用工厂函数创建
+     * @param key 网格键（类型 + 参数）
+     * @param factory 网格创建函数
+     */
+    std::shared_ptr<Mesh> getOrCreate(const std::string& key, const std::function<std::shared_ptr<Mesh>()>& factory);
+
+    /**
+     * @brief 缓存的网格数量
+     */
+    size_t size() const { return m_meshes.size(); }
+
+    /**
+     * @brief 释放所有缓存网格（仍被对象持有的网格在对象销毁时释放）
+     */
+    void clear();
+
+private:
+    InstanceBatcher* m_batcher;                                       // 实例化批处理器
+    std::unordered_map<std::string, std::shared_ptr<Mesh>> m_meshes;  // 键到网格的映射
+};
+
+#endif // MESH_CACHE_H
@@ -1,5 +1,6 @@
 ﻿#include "cube.h"
 #include "../engine.h"
+#include "../renderQueue.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 Cube::Cube(Engine* engine, const glm::vec3& position, const glm::vec3& size, Shader* shader, GLuint texture1, GLuint texture2)
@@ -8,61 +9,22 @@ Cube::Cube(Engine* engine, const glm::vec3& position, const glm::vec3& size, Sha
 {
     // 设置缩放
     setScale(size);
+    if (m_shader) m_modelLoc = m_shader->getUniformHandle("uModel");
     initMesh();
 }
 
 Cube::~Cube() {
-    delete m_vao;
+    // 网格由 MeshCache 共享持有，这里不删除
 }
 
 void Cube::initMesh() {
-    std::vector<float> vertices = {
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-         0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
-    };
-
-    auto Vbo = std::make_shared<Buffer<float>>(vertices, GL_ARRAY_BUFFER, GL_STATIC_DRAW);
-    m_vao = new VAO();
-    m_vao->addVBO(*Vbo, "3f 2f", GL_FALSE);
+    // 单位立方体，尺寸由模型矩阵缩放（无头模式没有几何缓存）
+    if (m_engine->headless) {
+        m_vao = nullptr;
+        return;
+    }
+    m_mesh = m_engine->meshCache->getCube();
+    m_vao = m_mesh->vao;
 }
 
 void Cube::update(float deltaTime) {
@@ -93,13 +55,8 @@ void Cube::render() const {
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, m_texture2);
 
-    // 计算并设置 Model 矩阵，使用父类的变换信息
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, m_position);
-    model = model * glm::mat4_cast(m_rotation);  // 使用四元数旋转
-    model = glm::scale(model, m_scale);
-
-    m_shader->setMat4("uModel", model);
+    // 设置 Model 矩阵，使用父类的变换信息
+    m_shader->setMat4(m_modelLoc, getModelMatrix());
     
     // 绘制
     m_vao->draw();
@@ -107,6 +64,40 @@ void Cube::render() const {
     m_shader->end();
 }
 
+void Cube::appendOccluderTriangles(std::vector<glm::vec3>& triangles) const {
+    // 单位立方体 8 个角点经模型矩阵变换，12 个三角形
+    const glm::mat4 model = getModelMatrix();
+    glm::vec3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec4 local((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f, 1.0f);
+        corners[i] = glm::vec3(model * local);
+    }
+
+    static const int faces[6][4] = {
+        { 0, 1, 3, 2 }, { 4, 6, 7, 5 },  // -Z, +Z
+        { 0, 2, 6, 4 }, { 1, 5, 7, 3 },  // -X, +X
+        { 0, 4, 5, 1 }, { 2, 3, 7, 6 }   // -Y, +Y
+    };
+    for (const auto& face : faces) {
+        triangles.insert(triangles.end(), { corners[face[0]], corners[face[1]], corners[face[2]] });
+        triangles.insert(triangles.end(), { corners[face[0]], corners[face[2]], corners[face[3]] });
+    }
+}
+
+void Cube::submit(RenderQueue& queue, const glm::mat4& model) const {
+    if (!m_shader) return;
+
+    DrawPacket packet;
+    packet.shader = m_shader;
+    packet.textures[0] = m_texture1;
+    packet.textures[1] = m_texture2;
+    packet.vao = m_vao;
+    packet.modelLoc = m_modelLoc;
+    packet.model = model;
+    packet.instanceable = true;
+    queue.submit(packet);
+}
+
 bool Cube::collideWith(const Object& other) const {
     // 简单的AABB碰撞检测占位符
     // 如果使用物理引擎，由物理引擎处理碰撞
@@ -116,8 +107,7 @@ bool Cube::collideWith(const Object& other) const {
 void Cube::applyForce(const glm::vec3& force) {
     // 如果有物理刚体，施加力
     if (m_rigidBody) {
-        rp3d::Vector3 rp3dForce(force.x, force.y, force.z);
-        m_rigidBody->applyWorldForceAtCenterOfMass(rp3dForce);
+        applyPhysicsForce(force);
     }
     // 如果没有物理体，什么也不做（或者可以直接修改速度）
 }
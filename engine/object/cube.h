@@ -6,6 +6,7 @@
 #include "../../glFrameWork/buffers.h"
 #include "../../glFrameWork/shader.h"
 #include "../../glFrameWork/texture.h"
+#include "../meshCache.h"
 
 class Cube : public Object {
 public:
@@ -20,6 +21,8 @@ public:
 
     void update(float deltaTime) override;
     void render() const override;
+    void submit(RenderQueue& queue, const glm::mat4& model) const override;
+    void appendOccluderTriangles(std::vector<glm::vec3>& triangles) const override;
     bool collideWith(const Object& other) const override;
 
     void setRotation(float angle, const glm::vec3& axis);
@@ -30,7 +33,9 @@ public:
 private:
     glm::vec3 m_size;
     Shader* m_shader;
-    VAO* m_vao;
+    UniformHandle m_modelLoc;  // 预解析的 uModel 位置
+    std::shared_ptr<MeshCache::Mesh> m_mesh;  // 共享几何（所有 Cube 共用）
+    VAO* m_vao;                               // m_mesh->vao，不拥有
     GLuint m_texture1;
     GLuint m_texture2;
     
@@ -1,6 +1,12 @@
 ﻿// Object.cpp
 #include "Object.h"
 #include "../engine.h"
+#include "../scene.h"
+#include "../renderQueue.h"
+#include "../physicsCommandQueue.h"
+#include "../collisionShapeCache.h"
+#include "../memoryAllocator.h"
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>"
 
 // 初始化静态对象计数器
@@ -40,45 +46,51 @@ Object::~Object() {
         m_rigidBody = nullptr;
     }
     
-    // 清理碰撞形状 - 使用 physicsCommon 的销毁方法
-    if (m_collisionShapeObj && m_engine) {
-        // 根据类型销毁碰撞形状
-        switch (m_collisionShape) {
-            case CollisionShape::BOX:
-                m_engine->physicsCommon.destroyBoxShape(static_cast<rp3d::BoxShape*>(m_collisionShapeObj));
-                break;
-            case CollisionShape::SPHERE:
-                m_engine->physicsCommon.destroySphereShape(static_cast<rp3d::SphereShape*>(m_collisionShapeObj));
-                break;
-            case CollisionShape::PLANE:
-                // Plane 使用 BoxShape 实现
-                m_engine->physicsCommon.destroyBoxShape(static_cast<rp3d::BoxShape*>(m_collisionShapeObj));
-                break;
-            case CollisionShape::CAPSULE:
-                m_engine->physicsCommon.destroyCapsuleShape(static_cast<rp3d::CapsuleShape*>(m_collisionShapeObj));
-                break;
-            default:
-                break;
-        }
+    // 释放共享碰撞形状（最后一个引用释放时由缓存销毁）
+    if (m_collisionShapeObj && m_engine && m_engine->shapeCache) {
+        m_engine->shapeCache->release(m_collisionShapeObj);
         m_collisionShapeObj = nullptr;
     }
 }
 
+void* Object::operator new(size_t size) {
+    return MemorySystem::instance().allocate(MemoryTag::SCENE, size);
+}
+
+void Object::operator delete(void* pointer, size_t size) {
+    MemorySystem::instance().deallocate(MemoryTag::SCENE, pointer, size);
+}
+
 /**
  * 更新实现。
  */
 void Object::update(float deltaTime) {
-    if (m_isActive) {
-        // 如果有物理体，从物理引擎同步
-        if (m_rigidBody && m_physicsType == PhysicsType::DYNAMIC) {
-            syncFromPhysics();
-        } else {
-            // 否则使用简单的速度更新
-            m_position += m_velocity * deltaTime;
-        }
+    // 动态刚体的变换由 Scene 在物理步进后批量同步；其余物体使用简单的速度更新
+    if (m_isActive && !isDynamicBody() && m_velocity != glm::vec3(0.0f)) {
+        m_position += m_velocity * deltaTime;
+        markTransformDirty();
     }
 }
 
+/**
+ * 设置名称，已加入场景时通知场景更新名称索引。
+ */
+void Object::setName(const std::string& name) {
+    if (name == m_name) return;
+    std::string oldName = std::move(m_name);
+    m_name = name;
+    if (m_handle.isValid() && m_engine && m_engine->scene) {
+        m_engine->scene->onObjectRenamed(this, oldName);
+    }
+}
+
+/**
+ * 默认以自定义方式提交，执行时调用 render()。
+ */
+void Object::submit(RenderQueue& queue, const glm::mat4& /*model*/) const {
+    queue.submitCustom(this);
+}
+
 /**
  * 销毁实现。
  */
@@ -88,8 +100,19 @@ void Object::destroy() {
 
 // ===== 变换相关实现 =====
 
+AABB Object::getWorldBounds() const {
+    return AABB::fromOrientedBox(m_position, m_scale * 0.5f, m_rotation);
+}
+
+glm::mat4 Object::getModelMatrix() const {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), m_position);
+    model = model * glm::mat4_cast(m_rotation);
+    return glm::scale(model, m_scale);
+}
+
 void Object::setPosition(const glm::vec3& position) {
     m_position = position;
+    markTransformDirty();
     // 如果有物理体，同步到物理引擎
     if (m_rigidBody && m_physicsType != PhysicsType::DYNAMIC) {
         syncToPhysics();
@@ -98,6 +121,7 @@ void Object::setPosition(const glm::vec3& position) {
 
 void Object::setRotation(const glm::quat& rotation) {
     m_rotation = rotation;
+    markTransformDirty();
     // 如果有物理体，同步到物理引擎
     if (m_rigidBody && m_physicsType != PhysicsType::DYNAMIC) {
         syncToPhysics();
@@ -106,6 +130,7 @@ void Object::setRotation(const glm::quat& rotation) {
 
 void Object::setRotationEuler(const glm::vec3& eulerAngles) {
     m_rotation = glm::quat(glm::radians(eulerAngles));
+    markTransformDirty();
     // 如果有物理体，同步到物理引擎
     if (m_rigidBody && m_physicsType != PhysicsType::DYNAMIC) {
         syncToPhysics();
@@ -114,10 +139,21 @@ void Object::setRotationEuler(const glm::vec3& eulerAngles) {
 
 void Object::setScale(const glm::vec3& scale) {
     m_scale = scale;
+    markTransformDirty();
 }
 
 void Object::setVelocity(const glm::vec3& velocity) {
     m_velocity = velocity;
+    if (!isDynamicBody()) return;
+    
+    PhysicsCommand command;
+    command.type = PhysicsCommand::Type::SET_VELOCITY;
+    command.target = m_handle;
+    command.vector = velocity;
+    if (deferPhysicsCommand(command)) return;
+    
+    m_rigidBody->setLinearVelocity(rp3d::Vector3(velocity.x, velocity.y, velocity.z));
+    wakeInScene();
 }
 
 // ===== 物理引擎相关实现 =====
@@ -126,6 +162,9 @@ void Object::initPhysics(PhysicsType type, CollisionShape shape, const glm::vec3
     if (!m_engine || !m_engine->pWorld) {
         return;
     }
+    if (m_engine->scene) {
+        m_engine->scene->waitForPhysics();  // 不能与工作线程上的物理步同时修改物理世界
+    }
 
     m_physicsType = type;
     m_collisionShape = shape;
@@ -137,6 +176,7 @@ void Object::initPhysics(PhysicsType type, CollisionShape shape, const glm::vec3
 
     // 创建刚体
     m_rigidBody = m_engine->pWorld->createRigidBody(transform);
+    m_rigidBody->setUserData(this);  // 接触事件中据此找回对象
 
     // 设置刚体类型
     switch (type) {
@@ -153,25 +193,24 @@ void Object::initPhysics(PhysicsType type, CollisionShape shape, const glm::vec3
             break;
     }
 
-    // 创建碰撞形状
+    // 从缓存获取碰撞形状（尺寸相同的对象共享同一个形状）
+    CollisionShapeCache* shapeCache = m_engine->shapeCache;
     switch (shape) {
         case CollisionShape::BOX: {
-            rp3d::Vector3 halfExtents(shapeSize.x * 0.5f, shapeSize.y * 0.5f, shapeSize.z * 0.5f);
-            m_collisionShapeObj = m_engine->physicsCommon.createBoxShape(halfExtents);
+            m_collisionShapeObj = shapeCache->acquireBox(shapeSize * 0.5f);
             break;
         }
         case CollisionShape::SPHERE: {
-            m_collisionShapeObj = m_engine->physicsCommon.createSphereShape(shapeSize.x);
+            m_collisionShapeObj = shapeCache->acquireSphere(shapeSize.x);
             break;
         }
         case CollisionShape::PLANE: {
             // 平面使用 BoxShape 模拟（薄的盒子）
-            rp3d::Vector3 halfExtents(shapeSize.x * 0.5f, 0.1f, shapeSize.z * 0.5f);
-            m_collisionShapeObj = m_engine->physicsCommon.createBoxShape(halfExtents);
+            m_collisionShapeObj = shapeCache->acquireBox(glm::vec3(shapeSize.x * 0.5f, 0.1f, shapeSize.z * 0.5f));
             break;
         }
         case CollisionShape::CAPSULE: {
-            m_collisionShapeObj = m_engine->physicsCommon.createCapsuleShape(shapeSize.x, shapeSize.y);
+            m_collisionShapeObj = shapeCache->acquireCapsule(shapeSize.x, shapeSize.y);
             break;
         }
         default:
@@ -189,6 +228,11 @@ void Object::initPhysics(PhysicsType type, CollisionShape shape, const glm::vec3
             m_rigidBody->updateMassPropertiesFromColliders();
         }
     }
+
+    // 已加入场景时通知场景重建动态刚体同步列表
+    if (m_handle.isValid() && m_engine->scene) {
+        m_engine->scene->onObjectPhysicsChanged(this);
+    }
 }
 
 void Object::syncFromPhysics() {
@@ -200,10 +244,46 @@ void Object::syncFromPhysics() {
 
     m_position = glm::vec3(rp3dPos.x, rp3dPos.y, rp3dPos.z);
     m_rotation = glm::quat(rp3dRot.w, rp3dRot.x, rp3dRot.y, rp3dRot.z);
+    markTransformDirty();
+}
+
+void Object::wakeInScene() {
+    if (m_handle.isValid() && m_engine && m_engine->scene) {
+        m_engine->scene->wakeObject(this);
+    }
+}
+
+void Object::applyPhysicsForce(const glm::vec3& force) {
+    if (!m_rigidBody) return;
+    
+    PhysicsCommand command;
+    command.type = PhysicsCommand::Type::APPLY_FORCE;
+    command.target = m_handle;
+    command.vector = force;
+    if (deferPhysicsCommand(command)) return;
+    if (m_handle.isValid() && m_engine && m_engine->scene) {
+        // 由场景按本帧时长计入下一批固定物理步
+        m_engine->scene->addFrameForce(this, force);
+        return;
+    }
+    
+    m_rigidBody->applyWorldForceAtCenterOfMass(rp3d::Vector3(force.x, force.y, force.z));
+    wakeInScene();
+}
+
+bool Object::deferPhysicsCommand(const PhysicsCommand& command) const {
+    return m_handle.isValid() && m_engine && m_engine->scene && m_engine->scene->queuePhysicsCommand(command);
 }
 
 void Object::syncToPhysics() {
     if (!m_rigidBody) return;
+    
+    PhysicsCommand command;
+    command.type = PhysicsCommand::Type::SET_TRANSFORM;
+    command.target = m_handle;
+    command.vector = m_position;
+    command.rotation = m_rotation;
+    if (deferPhysicsCommand(command)) return;
 
     rp3d::Vector3 rp3dPosition(m_position.x, m_position.y, m_position.z);
     rp3d::Quaternion rp3dRotation(m_rotation.x, m_rotation.y, m_rotation.z, m_rotation.w);
@@ -6,6 +6,9 @@
 #include <glm/gtc/quaternion.hpp>  // 四元数用于旋转
 #include <reactphysics3d/reactphysics3d.h>  // ReactPhysics3D物理引擎
 #include <string>  // 添加string头文件
+#include <vector>
+#include <cstdint>
+#include "../bounds.h"  // 世界空间包围盒
 
 /**
  * 游戏物体基类，提供基本的位置、速度、更新和渲染功能。
@@ -13,6 +16,23 @@
  */
 
 class Engine;
+class RenderQueue;
+struct PhysicsCommand;
+
+/**
+ * 场景对象句柄（分代槽位）。
+ * 对象被移除后槽位的代数递增，旧句柄随即失效，不会误指向复用该槽位的新对象。
+ */
+struct ObjectHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index{ INVALID_INDEX };  // 槽位索引
+    uint32_t generation{ 0 };         // 槽位代数
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool operator==(const ObjectHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const ObjectHandle& other) const { return !(*this == other); }
+};
 
 class Object {
 public:
@@ -50,6 +70,12 @@ public:
      */
     virtual ~Object();
 
+    /**
+     * 场景对象从 SCENE 标签的内存池分配
+     */
+    static void* operator new(size_t size);
+    static void operator delete(void* pointer, size_t size);
+
     /**
      * 更新物体状态，默认基于速度移动。
      * @param deltaTime 自上次更新以来经过的时间 (float)
@@ -61,6 +87,14 @@ public:
      */
     virtual void render() const = 0;
 
+    /**
+     * 向渲染队列提交绘制。默认以自定义方式提交（执行时调用 render()），
+     * 可描述为单个绘制包的子类应重写此方法以参与状态排序。
+     * @param queue 渲染队列
+     * @param model 场景本帧批量计算的模型矩阵
+     */
+    virtual void submit(RenderQueue& queue, const glm::mat4& model) const;
+
     /**
      * 检查与另一个物体的碰撞。此方法为占位符，子类需根据形状实现（如AABB、球体）。
      * @param other 另一个Object实例
@@ -96,10 +130,27 @@ public:
     // 设置缩放
     void setScale(const glm::vec3& scale);
 
+    // 获取模型矩阵（平移 * 旋转 * 缩放），子类可按自身网格约定重写
+    virtual glm::mat4 getModelMatrix() const;
+
+    // 获取世界空间包围盒（默认为以缩放为尺寸的单位盒子经旋转后的包围盒），用于可见性剔除
+    virtual AABB getWorldBounds() const;
+
+    // 遮挡体标记：大型不透明物体（墙、地板）在遮挡剔除阶段被光栅化到 CPU 深度缓冲
+    bool isOccluder() const { return m_isOccluder; }
+    void setOccluder(bool occluder) { m_isOccluder = occluder; }
+
+    // 追加遮挡用的世界空间三角形（每 3 个顶点一个），必须完全位于实际几何内部；默认不提供
+    virtual void appendOccluderTriangles(std::vector<glm::vec3>& /*triangles*/) const {}
+
+    // 场景包围体层次中的代理ID（由 Scene 管理，-1 表示未加入）
+    int getBoundsProxy() const { return m_boundsProxy; }
+    void setBoundsProxy(int proxy) { m_boundsProxy = proxy; }
+
     // 获取速度
     const glm::vec3& getVelocity() const { return m_velocity; }
 
-    // 设置速度
+    // 设置速度（动态刚体同时设置其线速度）
     void setVelocity(const glm::vec3& velocity);
 
     // 检查是否活跃
@@ -114,10 +165,20 @@ public:
     const std::string& getName() const { return m_name; }
     
     /**
-     * 设置对象名称
+     * 设置对象名称（已加入场景时同步更新场景的名称索引）
      * @param name 新的名称
      */
-    void setName(const std::string& name) { m_name = name; }
+    void setName(const std::string& name);
+
+    /**
+     * 获取场景句柄（未加入场景时无效）
+     */
+    ObjectHandle getHandle() const { return m_handle; }
+
+    /**
+     * 设置场景句柄（由 Scene 管理）
+     */
+    void setHandle(ObjectHandle handle) { m_handle = handle; }
 
     // ===== 物理引擎相关 =====
     
@@ -131,12 +192,35 @@ public:
     virtual void initPhysics(PhysicsType type, CollisionShape shape, const glm::vec3& shapeSize, float mass = 1.0f);
     
     /**
-     * 从物理引擎同步变換信息到渲染
+     * 从物理引擎同步变換信息到渲染（动态刚体由 Scene 在物理步进后批量同步，无需逐个调用）
      */
     void syncFromPhysics();
+
+    /**
+     * 写入物理引擎给出的变换（由 Scene 批量同步调用，不回写物理引擎）
+     */
+    void setTransformFromPhysics(const glm::vec3& position, const glm::quat& rotation) {
+        m_position = position;
+        m_rotation = rotation;
+    }
+
+    /**
+     * 是否为受物理引擎驱动的动态刚体
+     */
+    bool isDynamicBody() const { return m_rigidBody && m_physicsType == PhysicsType::DYNAMIC; }
+
+    /**
+     * 读取并清除变换脏标记（由 Scene 收集变换时调用）
+     * @return 自上次收集以来位置/旋转/缩放是否被修改
+     */
+    bool consumeTransformDirty() {
+        const bool dirty = m_transformDirty;
+        m_transformDirty = false;
+        return dirty;
+    }
     
     /**
-     * 将变换信息同步到物理引擎
+     * 将变换信息同步到物理引擎（流水线物理模式下排队到同步点执行）
      */
     void syncToPhysics();
     
@@ -172,7 +256,23 @@ protected:
     rp3d::Collider* m_collider;            // 碰撞体
     rp3d::CollisionShape* m_collisionShapeObj;  // 碰撞形状对象
 
+    // 子类直接修改 m_position/m_rotation/m_scale 后须调用，场景据此重新收集变换
+    void markTransformDirty() { m_transformDirty = true; }
+
+    // 施力等会唤醒刚体的操作后调用，把刚体放回场景的醒着集合
+    void wakeInScene();
+
+    // 在质心施加持续本帧的世界空间力，按帧时长计入下一批固定物理步（流水线物理模式下先排队到同步点）
+    void applyPhysicsForce(const glm::vec3& force);
+
+    // 场景处于流水线物理模式时把命令放入队列，返回 false 表示应直接操作刚体
+    bool deferPhysicsCommand(const PhysicsCommand& command) const;
+
 private:
+    int m_boundsProxy{ -1 };     // 场景 AABB 树代理ID
+    ObjectHandle m_handle;       // 场景句柄
+    bool m_isOccluder{ false };  // 是否作为遮挡体
+    bool m_transformDirty{ true };  // 变换是否需要被场景重新收集
     static int s_objectCounter;  // 对象计数器，用于生成唯一名称
 };
 
@@ -1,5 +1,6 @@
 ﻿#include "plane.h"
 #include "../engine.h"
+#include "../renderQueue.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 Plane::Plane(Engine* engine, const glm::vec3& position, const glm::vec2& size, Shader* shader, GLuint texture)
@@ -10,6 +11,7 @@ Plane::Plane(Engine* engine, const glm::vec3& position, const glm::vec2& size, S
       m_textureRepeatX(1.0f),
       m_textureRepeatZ(1.0f)
 {
+    if (m_shader) m_modelLoc = m_shader->getUniformHandle("uModel");
     initMesh();
 }
 
@@ -18,6 +20,11 @@ Plane::~Plane() {
 }
 
 void Plane::initMesh() {
+    if (m_engine->headless) {
+        m_vao = nullptr;  // 无头模式不创建 GPU 资源
+        return;
+    }
+    
     // 创建水平平面（XZ平面）的顶点数据
     // 格式：位置(x,y,z) + 纹理坐标(u,v)
     float halfWidth = m_size.x * 0.5f;
@@ -69,13 +76,8 @@ void Plane::render() const {
         glBindTexture(GL_TEXTURE_2D, m_texture);
     }
 
-    // 计算并设置 Model 矩阵
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, m_position);
-    model = model * glm::mat4_cast(m_rotation);
-    model = glm::scale(model, glm::vec3(m_scale.x, 1.0f, m_scale.z));
-
-    m_shader->setMat4("uModel", model);
+    // 设置 Model 矩阵
+    m_shader->setMat4(m_modelLoc, getModelMatrix());
     
     // 绘制
     m_vao->draw();
@@ -83,6 +85,36 @@ void Plane::render() const {
     m_shader->end();
 }
 
+void Plane::submit(RenderQueue& queue, const glm::mat4& model) const {
+    if (!m_shader) return;
+
+    DrawPacket packet;
+    packet.shader = m_shader;
+    packet.textures[0] = m_texture;
+    packet.vao = m_vao;
+    packet.modelLoc = m_modelLoc;
+    packet.model = model;
+    queue.submit(packet);
+}
+
+AABB Plane::getWorldBounds() const {
+    const glm::vec3 halfExtents(m_size.x * 0.5f * m_scale.x, 0.01f, m_size.y * 0.5f * m_scale.z);
+    return AABB::fromOrientedBox(m_position, halfExtents, m_rotation);
+}
+
+void Plane::appendOccluderTriangles(std::vector<glm::vec3>& triangles) const {
+    const glm::mat4 model = getModelMatrix();
+    const float halfWidth = m_size.x * 0.5f;
+    const float halfDepth = m_size.y * 0.5f;
+    const glm::vec3 corners[4] = {
+        glm::vec3(model * glm::vec4(-halfWidth, 0.0f, -halfDepth, 1.0f)),
+        glm::vec3(model * glm::vec4( halfWidth, 0.0f, -halfDepth, 1.0f)),
+        glm::vec3(model * glm::vec4( halfWidth, 0.0f,  halfDepth, 1.0f)),
+        glm::vec3(model * glm::vec4(-halfWidth, 0.0f,  halfDepth, 1.0f))
+    };
+    triangles.insert(triangles.end(), { corners[0], corners[1], corners[2], corners[2], corners[3], corners[0] });
+}
+
 bool Plane::collideWith(const Object& other) const {
     // 由物理引擎处理碰撞
     return false;
@@ -92,8 +124,7 @@ void Plane::applyForce(const glm::vec3& force) {
     // 平面通常是静态对象，不接受力
     // 如果有物理刚体且是动态的，可以施加力
     if (m_rigidBody && m_physicsType == PhysicsType::DYNAMIC) {
-        rp3d::Vector3 rp3dForce(force.x, force.y, force.z);
-        m_rigidBody->applyWorldForceAtCenterOfMass(rp3dForce);
+        applyPhysicsForce(force);
     }
     // 静态或运动学物体不响应力
 }
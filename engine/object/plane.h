@@ -30,6 +30,9 @@ public:
 
     void update(float deltaTime) override;
     void render() const override;
+    void submit(RenderQueue& queue, const glm::mat4& model) const override;
+    AABB getWorldBounds() const override;
+    void appendOccluderTriangles(std::vector<glm::vec3>& triangles) const override;
     bool collideWith(const Object& other) const override;
 
     /**
@@ -43,6 +46,7 @@ public:
 private:
     glm::vec2 m_size;           // 平面尺寸
     Shader* m_shader;           // 着色器
+    UniformHandle m_modelLoc;   // 预解析的 uModel 位置
     VAO* m_vao;                 // VAO
     GLuint m_texture;           // 纹理
     float m_textureRepeatX;     // 纹理X方向重复
@@ -44,7 +44,7 @@ std::vector<ComponentInfo> ConnectedComponents::analyzeComponents(
         }
         
         info.computeCenterOfMass();
-        info.computeBounds(searchRadius * 1.5f);
+        info.computeBounds(searchRadius * BOUNDS_MARGIN_SCALE);
         
         components.push_back(std::move(info));
     }
@@ -75,7 +75,7 @@ std::vector<int> ConnectedComponents::findComponent(
         
         // 查找邻居
         const glm::vec3& currentPos = positions[currentIdx];
-        std::vector<int> candidates = getCandidates(currentPos, cellSize);
+        TaggedVector<MemoryTag::MESHING, int> candidates = getCandidates(currentPos, cellSize);
         
         for (int neighborIdx : candidates) {
             if (visited[neighborIdx]) continue;
@@ -106,8 +106,8 @@ void ConnectedComponents::buildSpatialHash(
     }
 }
 
-std::vector<int> ConnectedComponents::getCandidates(const glm::vec3& pos, float cellSize) const {
-    std::vector<int> candidates;
+TaggedVector<MemoryTag::MESHING, int> ConnectedComponents::getCandidates(const glm::vec3& pos, float cellSize) const {
+    TaggedVector<MemoryTag::MESHING, int> candidates;
     candidates.reserve(64);
     
     // 检查周围27个格子
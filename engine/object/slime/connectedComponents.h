@@ -6,6 +6,7 @@
 #include <vector>
 #include <queue>
 #include <unordered_map>  // ✅ 添加缺失的头文件
+#include "../../memoryAllocator.h"
 
 class DensityField;
 
@@ -72,6 +73,9 @@ public:
     ConnectedComponents() = default;
     ~ConnectedComponents() = default;
 
+    // 连通块包围盒相对搜索半径的外扩倍数（密度场与网格表面都在此范围内）
+    static constexpr float BOUNDS_MARGIN_SCALE = 1.5f;
+
     /**
      * @brief 从粒子位置分析连通域
      * @param positions 所有粒子位置
@@ -119,10 +123,10 @@ private:
     /**
      * @brief 获取指定位置周围的粒子候选
      */
-    std::vector<int> getCandidates(const glm::vec3& pos, float cellSize) const;
+    TaggedVector<MemoryTag::MESHING, int> getCandidates(const glm::vec3& pos, float cellSize) const;
     
-    // 空间哈希表
-    std::unordered_map<int, std::vector<int>> m_spatialHash;
+    // 空间哈希表（走 MESHING 标签池）
+    TaggedUnorderedMap<MemoryTag::MESHING, int, TaggedVector<MemoryTag::MESHING, int>> m_spatialHash;
 };
 
 #endif // CONNECTED_COMPONENTS_H
@@ -4,6 +4,7 @@
 
 #include <glm/glm.hpp>
 #include <vector>
+#include "../../memoryAllocator.h"
 
 /**
  * @class DensityField
@@ -75,8 +76,8 @@ private:
     glm::vec3 m_boundsMax;         // 边界最大值
     glm::vec3 m_cellSize;          // 单个体素大小
     
-    std::vector<float> m_densities;  // 密度数据（线性存储）
-    std::vector<float> m_tempBuffer; // 临时缓冲（用于模糊）
+    TaggedVector<MemoryTag::MESHING, float> m_densities;  // 密度数据（线性存储）
+    TaggedVector<MemoryTag::MESHING, float> m_tempBuffer; // 临时缓冲（用于模糊）
 
     /**
      * @brief 将3D索引转换为1D索引
@@ -1,6 +1,8 @@
 ﻿// slime.cpp
 #include "slime.h"
 #include "../../engine.h"
+#include "../../scene.h"
+#include "../../profiler.h"
 #include "../../wrapper/widgets.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -13,7 +15,6 @@
 #include <thread>     //  线程支持
 #include <mutex>      //  互斥锁
 #include <atomic>     //  原子操作
-#include <chrono>     //  ✅ 性能计时
 
 // 常量
 const float PI = 3.14159265359f;
@@ -32,6 +33,8 @@ Slime::Slime(Engine* engine, const glm::vec3& position, float radius,
       m_meshShader(meshShader),                  // 网格渲染着色器
       m_texture(texture),                        // 纹理ID
       m_sphereIndexCount(0),                     // 球体网格索引数量（用于实例化渲染）
+      m_impostorShader(nullptr),                 // 球体替身着色器（通过 setImpostorShader 设置）
+      m_impostorVAO(nullptr),                    // 球体替身VAO（四边形 + 实例数据）
       m_renderMode(RenderMode::PARTICLES),       // 默认渲染模式：粒子球体
       m_meshResolution(28),                      // 密度场网格分辨率（用于Marching Cubes）
       m_isoLevel(0.5f),                         // 等值面阈值（密度大于此值为实心）
@@ -53,8 +56,9 @@ Slime::Slime(Engine* engine, const glm::vec3& position, float radius,
     std::iota(m_particleIndices.begin(), m_particleIndices.end(), 0);
     
     // 在球体内随机分布粒子
+    // 引擎指定了种子（录制/回放）时使用固定种子，保证初始分布可复现
     std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(m_engine->randomSeed != 0 ? m_engine->randomSeed : rd());
     std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
     
     for (auto& particle : m_particles) {
@@ -77,8 +81,11 @@ Slime::Slime(Engine* engine, const glm::vec3& position, float radius,
     // 设置网格大小为粒子搜索半径
     m_cellSize = m_particleRadius * 4.0f;
     
-    // 初始化渲染数据
-    initRenderData();
+    // 初始化渲染数据（无头模式只做模拟与 CPU 网格生成）
+    if (!m_engine->headless) {
+        initRenderData();
+    }
+    updateBounds();
     
     // ✅ 初始化 Marching Cubes 和连通域分析器
     m_marchingCubes = new MarchingCubes();
@@ -93,6 +100,7 @@ Slime::Slime(Engine* engine, const glm::vec3& position, float radius,
 
 Slime::~Slime() {
     delete m_particleVAO;
+    delete m_impostorVAO;
     delete m_meshVAO;
     delete m_marchingCubes;
     delete m_connectedComponents;
@@ -105,28 +113,38 @@ Slime::~Slime() {
 
 void Slime::initRenderData() {
     // ===== 粒子渲染数据 =====
-    // 创建一个小球体网格作为粒子的基础模型
-    widgets::SphereData sphereData = widgets::createSphere(m_particleRadius, 8, 6);
+    // 创建单位球体网格作为粒子的基础模型（实际半径由实例数据缩放）
+    widgets::SphereData sphereData = widgets::createSphere(1.0f, 8, 6);
     
     m_sphereVBO = std::make_shared<Buffer<float>>(sphereData.vertices, GL_ARRAY_BUFFER, GL_STATIC_DRAW);
     m_sphereEBO = std::make_shared<Buffer<unsigned int>>(sphereData.indices, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
     m_sphereIndexCount = sphereData.indices.size();
     
-    // 创建实例化矩阵缓冲（作为float数组）
-    std::vector<float> instanceData(m_particles.size() * 16);  // mat4 = 16个float
-    for (size_t i = 0; i < m_particles.size(); ++i) {
-        glm::mat4 matrix = glm::translate(glm::mat4(1.0f), m_particles[i].position);
-        memcpy(&instanceData[i * 16], glm::value_ptr(matrix), 16 * sizeof(float));
-    }
-    
-    m_instanceVBO = std::make_shared<Buffer<float>>(instanceData, GL_ARRAY_BUFFER, GL_DYNAMIC_DRAW);
+    // 创建紧凑实例缓冲：每个粒子 vec3 位置 + float 半径（16 字节，取代 64 字节的 mat4）
+    // 持久映射的三缓冲，每帧直接写入映射内存
+    m_instanceBuffer = std::make_shared<StreamingBuffer<ParticleInstance>>(m_particles.size());
+    updateInstanceBuffer();
     
     // 配置粒子VAO
     m_particleVAO = new VAO();
     m_particleVAO->addVBO(*m_sphereVBO, "3f 3f 2f", GL_FALSE, 0);  // 顶点数据: pos, normal, texCoord
-    m_particleVAO->addInstancedVBO(*m_instanceVBO, "4f 4f 4f 4f", 3, 1);  // 从location 3开始
+    m_particleVAO->addInstancedVBO(*m_instanceBuffer, "4f", 3, 1);  // location 3: xyz 位置 + w 半径
     m_particleVAO->addEBO(*m_sphereEBO);
     
+    // ===== 球体替身渲染数据 =====
+    // 单位四边形（三角形带），在顶点着色器中按粒子半径展开并朝向相机
+    std::vector<float> quadVertices = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+        -1.0f,  1.0f,
+         1.0f,  1.0f
+    };
+    m_quadVBO = std::make_shared<Buffer<float>>(quadVertices, GL_ARRAY_BUFFER, GL_STATIC_DRAW);
+    
+    m_impostorVAO = new VAO();
+    m_impostorVAO->addVBO(*m_quadVBO, "2f", GL_FALSE, 0);            // location 0: 四边形角点
+    m_impostorVAO->addInstancedVBO(*m_instanceBuffer, "4f", 3, 1);   // location 3: 与粒子模式共享实例数据
+    
     // ✅ 网格渲染数据（不再需要预分配大缓冲区，每个块独立创建）
     // 保留这些成员变量用于向后兼容，但不使用
     m_meshVAO = nullptr;
@@ -139,6 +157,8 @@ void Slime::initRenderData() {
 }
 
 void Slime::update(float deltaTime) {
+    PROFILE_SCOPE("Slime::update");
+    
     // 限制时间步长，避免不稳定
     const float maxDt = 0.016f;  // 约60fps
     deltaTime = std::min(deltaTime, maxDt);
@@ -164,8 +184,8 @@ void Slime::update(float deltaTime) {
     handlePhysicsCollisions();
     
     // 更新渲染数据
-    if (m_renderMode == RenderMode::PARTICLES) {
-        updateInstanceBuffer();
+    if (m_renderMode == RenderMode::PARTICLES || m_renderMode == RenderMode::IMPOSTOR) {
+        if (m_instanceBuffer) updateInstanceBuffer();
     } else {
         // 网格模式：定期更新网格
         m_meshUpdateTimer += deltaTime;
@@ -178,11 +198,42 @@ void Slime::update(float deltaTime) {
     
     //  更新质心位置（用于相机跟踪）
     m_position = getCenterOfMass();
+    markTransformDirty();
+    
+    updateBounds();
+}
+
+void Slime::updateBounds() {
+    PROFILE_SCOPE("Slime::updateBounds");
+    if (m_particles.empty()) {
+        m_bounds = AABB(m_position, m_position);
+        return;
+    }
+    
+    // 并行归约所有粒子位置的包围盒
+    AABB initial(m_particles[0].position, m_particles[0].position);
+    m_bounds = std::transform_reduce(std::execution::par_unseq,
+        m_particles.begin(), m_particles.end(), initial,
+        [](const AABB& a, const AABB& b) { return AABB::merge(a, b); },
+        [](const Particle& p) { return AABB(p.position, p.position); });
+    
+    if (m_renderMode != RenderMode::MESH) {
+        // 外扩粒子半径（粒子模式下实际绘制的球体半径）
+        m_bounds = m_bounds.expanded(m_particleRadius);
+        return;
+    }
+    
+    // 网格模式：表面延伸到连通块包围盒的外扩范围；网格定期才重建，仍在绘制的旧网格也须包含在内
+    m_bounds = m_bounds.expanded(getComponentSearchRadius() * ConnectedComponents::BOUNDS_MARGIN_SCALE);
+    for (const auto& compMesh : m_componentMeshes) {
+        m_bounds = AABB::merge(m_bounds, compMesh.bounds);
+    }
 }
 
 
 //  并行优化：施加外力（删除串行代码）
 void Slime::applyExternalForces(float dt) {
+    PROFILE_SCOPE("Slime::applyExternalForces");
     const glm::vec3 gravity(0.0f, -9.81f, 0.0f);
     
     //  纯并行处理
@@ -194,6 +245,7 @@ void Slime::applyExternalForces(float dt) {
 
 //  并行优化：预测位置（删除串行代码）
 void Slime::predictPositions(float dt) {
+    PROFILE_SCOPE("Slime::predictPositions");
     
     std::for_each(std::execution::par_unseq, m_particles.begin(), m_particles.end(),
         [dt](Particle& particle) {
@@ -205,6 +257,7 @@ void Slime::predictPositions(float dt) {
 
 //  并行优化：构建空间哈希（Lock-Free 优化）
 void Slime::buildSpatialHash() {
+    PROFILE_SCOPE("Slime::buildSpatialHash");
     m_spatialHash.clear();
     
     //  第一步：并行计算所有粒子的哈希键
@@ -217,6 +270,7 @@ void Slime::buildSpatialHash() {
         });
     
     //  第二步：串行合并到哈希表（这部分很快，不需要并行）
+    PROFILE_SCOPE("mergeSpatialHash");
     for (const auto& [key, idx] : hashKeyPairs) {
         m_spatialHash[key].push_back(idx);
     }
@@ -224,14 +278,16 @@ void Slime::buildSpatialHash() {
 
 //  并行优化：更新邻居（删除串行代码）
 void Slime::updateNeighbors() {
+    PROFILE_SCOPE("Slime::updateNeighbors");
     const float h = m_particleRadius * 4.0f;
     const float h_sq = h * h;  //  优化：避免重复计算平方根
     
     //  纯并行处理
     std::for_each(std::execution::par, m_particleIndices.begin(), m_particleIndices.end(),
         [this, h_sq](int i) {
+            PROFILE_PARALLEL_SCOPE("neighborQuery");
             m_neighbors[i].clear();
-            std::vector<int> candidates = getNeighbors(m_particles[i].predictedPos);
+            TaggedVector<MemoryTag::SLIME, int> candidates = getNeighbors(m_particles[i].predictedPos);
             
             //  预分配空间，减少动态分配
             m_neighbors[i].reserve(32);
@@ -252,15 +308,18 @@ void Slime::updateNeighbors() {
 
 //  并行优化：约束求解（删除串行代码）
 void Slime::solveConstraints() {
+    PROFILE_SCOPE("Slime::solveConstraints");
     //  第一步：并行计算 lambda
     std::for_each(std::execution::par, m_particleIndices.begin(), m_particleIndices.end(),
         [this](int i) {
+            PROFILE_PARALLEL_SCOPE("computeLambda");
             m_particles[i].lambda = computeLambda(i);
         });
     
     //  第二步：并行计算位置修正
     std::for_each(std::execution::par, m_particleIndices.begin(), m_particleIndices.end(),
         [this](int i) {
+            PROFILE_PARALLEL_SCOPE("computeDeltaP");
             m_particles[i].deltaPos = computeDeltaP(i);
         });
     
@@ -273,6 +332,7 @@ void Slime::solveConstraints() {
 
 //  并行优化：更新速度（删除串行代码）
 void Slime::updateVelocities(float dt) {
+    PROFILE_SCOPE("Slime::updateVelocities");
     const float invDt = 1.0f / dt;  //  优化：避免除法
     
     std::for_each(std::execution::par_unseq, m_particles.begin(), m_particles.end(),
@@ -284,6 +344,7 @@ void Slime::updateVelocities(float dt) {
 
 //  并行优化：向心力
 void Slime::applyCohesionForce() {
+    PROFILE_SCOPE("Slime::applyCohesionForce");
     const glm::vec3 centerOfMass = getCenterOfMass();
     const glm::vec3 targetCenter = centerOfMass + glm::vec3(0.0f, m_slimeRadius * 0.2f, 0.0f);
     
@@ -299,6 +360,7 @@ void Slime::applyCohesionForce() {
     std::for_each(std::execution::par, m_particleIndices.begin(), m_particleIndices.end(),
         [this, centerOfMass, targetCenter, radiusThreshold, invRadius, 
          idealDist, maxAttractionDist, attractionRange, maxForce](int i) {
+            PROFILE_PARALLEL_SCOPE("cohesion");
             auto& particle = m_particles[i];
             glm::vec3 toTarget = targetCenter - particle.position;
             float dist = glm::length(toTarget);
@@ -346,8 +408,10 @@ void Slime::applyCohesionForce() {
 
 //  并行优化：粘性（删除串行代码）
 void Slime::applyViscosity() {
+    PROFILE_SCOPE("Slime::applyViscosity");
     std::for_each(std::execution::par, m_particleIndices.begin(), m_particleIndices.end(),
         [this](int i) {
+            PROFILE_PARALLEL_SCOPE("viscosity");
             glm::vec3 velocityChange(0.0f);
             int neighborCount = m_neighbors[i].size();
             
@@ -445,8 +509,8 @@ int Slime::getHashKey(const glm::vec3& pos) {
     return (x * 73856093) ^ (y * 19349663) ^ (z * 83492791);
 }
 
-std::vector<int> Slime::getNeighbors(const glm::vec3& pos) {
-    std::vector<int> neighbors;
+TaggedVector<MemoryTag::SLIME, int> Slime::getNeighbors(const glm::vec3& pos) {
+    TaggedVector<MemoryTag::SLIME, int> neighbors;
     neighbors.reserve(64);  //  预分配空间
     
     // 检查当前格子和周围26个格子
@@ -469,6 +533,7 @@ std::vector<int> Slime::getNeighbors(const glm::vec3& pos) {
 
 //  优化：并行碰撞检测（分块处理）
 void Slime::handlePhysicsCollisions() {
+    PROFILE_SCOPE("Slime::handlePhysicsCollisions");
     if (!m_engine) return;
     
     auto* world = m_engine->getPhysicsWorld();
@@ -482,6 +547,7 @@ void Slime::handlePhysicsCollisions() {
     //  并行处理碰撞检测
     std::for_each(std::execution::par, m_particleIndices.begin(), m_particleIndices.end(),
         [this, world, checkDistance, restitution, friction, minSpeed](int idx) {
+            PROFILE_PARALLEL_SCOPE("collisionQuery");
             auto& particle = m_particles[idx];
             float speed = glm::length(particle.velocity);
             
@@ -539,22 +605,27 @@ void Slime::handlePhysicsCollisions() {
         });
 }
 
-//  优化：并行更新实例缓冲
+//  优化：并行更新实例缓冲（紧凑格式，直接写入持久映射内存）
 void Slime::updateInstanceBuffer() {
-    std::vector<float> instanceData(m_particles.size() * 16);
+    PROFILE_SCOPE("Slime::updateInstanceBuffer");
+    const float radius = m_particleRadius;
+    ParticleInstance* instances = m_instanceBuffer->beginWrite();
     
-    //  并行生成矩阵数据
+    //  并行写入位置和半径，无中间 std::vector，也没有 glBufferSubData 同步
     std::for_each(std::execution::par_unseq, m_particleIndices.begin(), m_particleIndices.end(),
-        [this, &instanceData](int i) {
-            glm::mat4 matrix = glm::translate(glm::mat4(1.0f), m_particles[i].position);
-            memcpy(&instanceData[i * 16], glm::value_ptr(matrix), 16 * sizeof(float));
+        [this, radius, instances](int i) {
+            instances[i].position = m_particles[i].position;
+            instances[i].radius = radius;
         });
     
-    //  使用封装的 update 方法更新GPU缓冲
-    m_instanceVBO->update(instanceData, 0);
+    m_instanceBuffer->endWrite();
 }
 
 void Slime::render() const {
+    // 按渲染模式分开计时，便于比较各模式的 GPU 开销
+    static const char* const gpuZoneNames[] = { "Slime::renderParticles", "Slime::renderMesh", "Slime::renderImpostor" };
+    GPU_TIMER_SCOPE(m_engine->gpuTimer, gpuZoneNames[static_cast<int>(m_renderMode)]);
+    
     if (m_renderMode == RenderMode::PARTICLES) {
         // 粒子球体模式
         if (!m_particleShader) return;
@@ -570,10 +641,22 @@ void Slime::render() const {
         // 设置史莱姆颜色
         m_particleShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
         
-        // 实例化绘制所有粒子
-        m_particleVAO->drawInstanced(m_particles.size(), m_sphereIndexCount);
+        // 实例化绘制所有粒子（从实例缓冲的当前区域读取），之后插入 fence
+        m_particleVAO->drawInstanced(m_particles.size(), m_sphereIndexCount, GL_TRIANGLES, m_instanceBuffer->drawOffset());
+        m_instanceBuffer->fence();
         
         m_particleShader->end();
+    } else if (m_renderMode == RenderMode::IMPOSTOR) {
+        // 球体替身模式：每个粒子一个四边形，片元着色器求交并写入正确深度
+        if (!m_impostorShader) return;
+        
+        m_impostorShader->begin();
+        m_impostorShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
+        
+        m_impostorVAO->drawInstanced(m_particles.size(), 0, GL_TRIANGLE_STRIP, m_instanceBuffer->drawOffset());
+        m_instanceBuffer->fence();
+        
+        m_impostorShader->end();
     } else {
         // ✅ 网格模式：渲染所有独立块
         if (!m_meshShader || m_componentMeshes.empty()) return;
@@ -593,8 +676,10 @@ void Slime::render() const {
         // 设置史莱姆颜色
         m_meshShader->set("uSlimeColor", glm::vec3(0.3f, 1.0f, 0.5f));
         
-        // ✅ 渲染每个独立的网格块
+        // ✅ 渲染每个独立的网格块，跳过视锥外的块
+        const Frustum* frustum = (m_engine && m_engine->scene) ? &m_engine->scene->getFrustum() : nullptr;
         for (const auto& compMesh : m_componentMeshes) {
+            if (frustum && !frustum->isVisible(compMesh.bounds)) continue;
             if (compMesh.indexCount > 0 && compMesh.vao) {
                 compMesh.vao->draw(GL_TRIANGLES, compMesh.indexCount);
             }
@@ -607,7 +692,16 @@ void Slime::render() const {
 }
 
 void Slime::toggleRenderMode() {
+    // 循环切换：粒子 -> 替身 -> 网格 -> 粒子（未设置替身 shader 时跳过替身模式）
     if (m_renderMode == RenderMode::PARTICLES) {
+        if (m_impostorShader) {
+            m_renderMode = RenderMode::IMPOSTOR;
+            std::cout << "[Slime] 切换到球体替身渲染模式" << std::endl;
+        } else {
+            m_renderMode = RenderMode::MESH;
+            std::cout << "[Slime] 切换到网格渲染模式" << std::endl;
+        }
+    } else if (m_renderMode == RenderMode::IMPOSTOR) {
         m_renderMode = RenderMode::MESH;
         std::cout << "[Slime] 切换到网格渲染模式" << std::endl;
     } else {
@@ -618,23 +712,26 @@ void Slime::toggleRenderMode() {
 
 // 多块网格生成
 void Slime::generateMeshes() {
-    // 性能计时
-    auto startTime = std::chrono::high_resolution_clock::now();
+    PROFILE_SCOPE("Slime::generateMeshes");
     
     // 1. 提取粒子位置
     std::vector<glm::vec3> positions(m_particles.size());
-    std::transform(std::execution::par_unseq,
-                   m_particles.begin(), m_particles.end(),
-                   positions.begin(),
-                   [](const Particle& p) { return p.position; });
+    {
+        PROFILE_SCOPE("extractPositions");
+        std::transform(std::execution::par_unseq,
+                       m_particles.begin(), m_particles.end(),
+                       positions.begin(),
+                       [](const Particle& p) { return p.position; });
+    }
     
     // 2. 使用连通域分析将粒子分组
-    float searchRadius = m_particleRadius * 4.0f;  // 与邻居搜索半径一致
+    float searchRadius = getComponentSearchRadius();
     
-    auto connStart = std::chrono::high_resolution_clock::now();
-    std::vector<ComponentInfo> components = 
-        m_connectedComponents->analyzeComponents(positions, searchRadius, m_minComponentSize);
-    auto connEnd = std::chrono::high_resolution_clock::now();
+    std::vector<ComponentInfo> components;
+    {
+        PROFILE_SCOPE("connectedComponents");
+        components = m_connectedComponents->analyzeComponents(positions, searchRadius, m_minComponentSize);
+    }
     
     // 3. 清理旧的网格
     for (auto& compMesh : m_componentMeshes) {
@@ -647,34 +744,42 @@ void Slime::generateMeshes() {
     }
     
     // 4. 为每个连通块生成独立的网格
-    auto meshStart = std::chrono::high_resolution_clock::now();
-    
     // ✅ 并行生成所有块的网格数据
     std::vector<MeshData> meshDataList(components.size());
-    std::vector<int> compIndices(components.size());
-    std::iota(compIndices.begin(), compIndices.end(), 0);
-    
-    std::for_each(std::execution::par, compIndices.begin(), compIndices.end(),
-        [this, &components, &meshDataList](int compIdx) {
-            const auto& component = components[compIdx];
-            
-            // 为该块创建密度场
-            DensityField densityField(component.boundsMin, component.boundsMax, m_meshResolution);
-            
-            // 构建密度场（只使用该块的粒子）
-            densityField.buildFromParticles(component.particlePositions, m_particleRadius);
-            
-            // 应用模糊
-            densityField.applyBlur(m_blurIterations);
-            
-            // 使用 Marching Cubes 生成网格
-            meshDataList[compIdx] = m_marchingCubes->generateMesh(densityField, m_isoLevel);
-        });
-    
-    auto meshEnd = std::chrono::high_resolution_clock::now();
+    {
+        PROFILE_SCOPE("componentMeshes");
+        std::vector<int> compIndices(components.size());
+        std::iota(compIndices.begin(), compIndices.end(), 0);
+        
+        std::for_each(std::execution::par, compIndices.begin(), compIndices.end(),
+            [this, &components, &meshDataList](int compIdx) {
+                PROFILE_SCOPE("componentMesh");
+                const auto& component = components[compIdx];
+                
+                // 为该块创建密度场
+                DensityField densityField(component.boundsMin, component.boundsMax, m_meshResolution);
+                
+                // 构建密度场（只使用该块的粒子）
+                {
+                    PROFILE_SCOPE("DensityField::buildFromParticles");
+                    densityField.buildFromParticles(component.particlePositions, m_particleRadius);
+                }
+                
+                // 应用模糊
+                {
+                    PROFILE_SCOPE("DensityField::applyBlur");
+                    densityField.applyBlur(m_blurIterations);
+                }
+                
+                // 使用 Marching Cubes 生成网格
+                PROFILE_SCOPE("MarchingCubes::generateMesh");
+                meshDataList[compIdx] = m_marchingCubes->generateMesh(densityField, m_isoLevel);
+            });
+    }
     
     // 5. 串行创建 GPU 缓冲区（OpenGL 调用必须在主线程）
-    auto bufferStart = std::chrono::high_resolution_clock::now();
+    PROFILE_SCOPE("uploadBuffers");
+    const bool upload = !m_engine->headless;
     
     for (size_t compIdx = 0; compIdx < components.size(); ++compIdx) {
         const auto& meshData = meshDataList[compIdx];
@@ -688,6 +793,13 @@ void Slime::generateMeshes() {
         ComponentMesh compMesh;
         compMesh.meshData = meshData;  // 复制而非移动，因为我们需要保留数据
         compMesh.indexCount = compMesh.meshData.indices.size();
+        compMesh.bounds = AABB(components[compIdx].boundsMin, components[compIdx].boundsMax);
+        
+        if (!upload) {
+            // 无头模式只保留 CPU 网格数据
+            m_componentMeshes.push_back(std::move(compMesh));
+            continue;
+        }
         
         // 准备顶点数据（位置 + 法线）
         const size_t vertexCapacity = compMesh.meshData.vertexCount() * 6;  // pos + normal
@@ -724,35 +836,6 @@ void Slime::generateMeshes() {
         
         m_componentMeshes.push_back(std::move(compMesh));
     }
-    
-    auto bufferEnd = std::chrono::high_resolution_clock::now();
-    auto endTime = std::chrono::high_resolution_clock::now();
-    
-    // 性能统计（每10帧输出一次）
-    static int frameCounter = 0;
-    if (++frameCounter >= 120) {
-        frameCounter = 0;
-        
-        auto connTime = std::chrono::duration_cast<std::chrono::microseconds>(connEnd - connStart).count();
-        auto meshTime = std::chrono::duration_cast<std::chrono::microseconds>(meshEnd - meshStart).count();
-        auto bufferTime = std::chrono::duration_cast<std::chrono::microseconds>(bufferEnd - bufferStart).count();
-        auto totalTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
-        
-        size_t totalVertices = 0;
-        size_t totalTriangles = 0;
-        for (const auto& compMesh : m_componentMeshes) {
-            totalVertices += compMesh.meshData.vertexCount();
-            totalTriangles += compMesh.meshData.triangleCount();
-        }
-        
-        std::cout << "[Slime] 网格生成性能 - 总时间: " << (totalTime / 1000.0f) << "ms"
-                  << " | 连通域: " << (connTime / 1000.0f) << "ms"
-                  << " | 网格: " << (meshTime / 1000.0f) << "ms"
-                  << " | 缓冲: " << (bufferTime / 1000.0f) << "ms"
-                  << " | 块数: " << m_componentMeshes.size()
-                  << " | 顶点: " << totalVertices
-                  << " | 三角形: " << totalTriangles << std::endl;
-    }
 }
 
 // ✅ 修改：updateMeshBuffers 不再需要（缓冲区在 generateMeshes 中创建）
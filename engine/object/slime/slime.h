@@ -8,6 +8,7 @@
 #include "densityField.h"
 #include "marchingCubes.h"
 #include "connectedComponents.h"
+#include "../../memoryAllocator.h"
 #include <glm/glm.hpp>
 #include <vector>
 #include <memory>
@@ -25,7 +26,8 @@ public:
     // 渲染模式枚举
     enum class RenderMode {
         PARTICLES,  // 粒子球体模式
-        MESH        // 动态网格模式
+        MESH,       // 动态网格模式
+        IMPOSTOR    // 球体替身模式（每粒子一个屏幕对齐四边形，片元着色器光线求交）
     };
 
     // 粒子结构
@@ -58,6 +60,9 @@ public:
     virtual bool collideWith(const Object& other) const override;
     virtual void applyForce(const glm::vec3& force) override;
     
+    // 包围所有粒子的世界包围盒（每帧模拟后更新）
+    virtual AABB getWorldBounds() const override { return m_bounds; }
+    
     // 获取史莱姆中心位置（质心）
     glm::vec3 getCenterOfMass() const;
     
@@ -70,7 +75,8 @@ public:
     // ✅ 访问粒子数据的接口
     const std::vector<Particle>& getParticles() const { return m_particles; }
     Particle& getParticleMutable(int index) { return m_particles[index]; }
-    const std::vector<std::vector<int>>& getNeighbors() const { return m_neighbors; }
+    using NeighborList = TaggedVector<MemoryTag::SLIME, int>;
+    const TaggedVector<MemoryTag::SLIME, NeighborList>& getNeighbors() const { return m_neighbors; }
     float getSlimeRadius() const { return m_slimeRadius; }
     
     // ✅ 渲染模式控制
@@ -78,6 +84,9 @@ public:
     RenderMode getRenderMode() const { return m_renderMode; }
     void toggleRenderMode();
     
+    // ✅ 球体替身渲染 shader（为空时跳过 IMPOSTOR 模式）
+    void setImpostorShader(Shader* shader) { m_impostorShader = shader; }
+    
     // ✅ 网格生成参数
     void setMeshResolution(int resolution) { m_meshResolution = resolution; }
     void setIsoLevel(float level) { m_isoLevel = level; }
@@ -88,6 +97,9 @@ public:
     int getComponentCount() const { return m_componentMeshes.size(); }
 
 private:
+    friend class SlimeKernelBench;  // bench/microBench.cpp 单独计时各模拟阶段
+    friend class Snapshot;          // 快照直接读写粒子数组
+
     // PBF算法步骤
     void applyExternalForces(float dt);
     void predictPositions(float dt);
@@ -106,11 +118,13 @@ private:
     // 空间哈希
     void buildSpatialHash();
     int getHashKey(const glm::vec3& pos);
-    std::vector<int> getNeighbors(const glm::vec3& pos);
+    TaggedVector<MemoryTag::SLIME, int> getNeighbors(const glm::vec3& pos);
     
     // 渲染相关
     void initRenderData();
     void updateInstanceBuffer();
+    void updateBounds();
+    float getComponentSearchRadius() const { return m_particleRadius * 4.0f; }  // 连通域搜索半径，与邻居搜索半径一致
     
     // ✅ 多块网格生成
     void generateMeshes();
@@ -132,11 +146,12 @@ private:
     
     // 粒子数据
     std::vector<Particle> m_particles;
-    std::vector<std::vector<int>> m_neighbors;
+    AABB m_bounds;  // 所有粒子的包围盒
+    TaggedVector<MemoryTag::SLIME, NeighborList> m_neighbors;  // 每帧并行重建，走 SLIME 标签池
     std::vector<int> m_particleIndices;
     
     // 空间哈希
-    std::unordered_map<int, std::vector<int>> m_spatialHash;
+    TaggedUnorderedMap<MemoryTag::SLIME, int, TaggedVector<MemoryTag::SLIME, int>> m_spatialHash;  // 每帧重建，走 SLIME 标签池
     float m_cellSize;
     
     // 渲染数据（粒子模式）
@@ -145,9 +160,20 @@ private:
     VAO* m_particleVAO;
     std::shared_ptr<Buffer<float>> m_sphereVBO;
     std::shared_ptr<Buffer<unsigned int>> m_sphereEBO;
-    std::shared_ptr<Buffer<float>> m_instanceVBO;
+    
+    // 紧凑实例数据（16 字节，对应 shader 中 location 3 的 vec4）
+    struct ParticleInstance {
+        glm::vec3 position;  // 粒子位置
+        float radius;        // 粒子半径
+    };
+    std::shared_ptr<StreamingBuffer<ParticleInstance>> m_instanceBuffer;  // 持久映射实例缓冲，直接写入无中间拷贝
     size_t m_sphereIndexCount;
     
+    // ✅ 球体替身渲染数据（与粒子模式共享实例缓冲）
+    Shader* m_impostorShader;
+    VAO* m_impostorVAO;
+    std::shared_ptr<Buffer<float>> m_quadVBO;
+    
     // ✅ 网格渲染数据（保留单一VAO用于初始化）
     Shader* m_meshShader;
     VAO* m_meshVAO;
@@ -162,6 +188,7 @@ private:
         std::shared_ptr<Buffer<unsigned int>> ebo;
         VAO* vao;
         size_t indexCount;
+        AABB bounds;  // 连通块包围盒（来自 ComponentInfo），用于视锥剔除
         
         ComponentMesh() : vao(nullptr), indexCount(0) {}
         ~ComponentMesh() { 
@@ -1,6 +1,6 @@
 ﻿#include "sphere.h"
 #include "../engine.h"
-#include "../../wrapper/widgets.h"
+#include "../renderQueue.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 Sphere::Sphere(Engine* engine, const glm::vec3& position, float radius, Shader* shader, GLuint texture)
@@ -8,25 +8,24 @@ Sphere::Sphere(Engine* engine, const glm::vec3& position, float radius, Shader*
 {
     // 设置缩放为半径
     setScale(glm::vec3(radius));
+    if (m_shader) m_modelLoc = m_shader->getUniformHandle("uModel");
     initMesh();
 }
 
 Sphere::~Sphere() {
-    delete m_vao;
+    // 网格由 MeshCache 共享持有，这里不删除
 }
 
 void Sphere::initMesh() {
-    widgets::SphereData data = widgets::createSphere(m_radius, 36, 18);
-    
-    m_vbo = std::make_shared<Buffer<float>>(data.vertices, GL_ARRAY_BUFFER, GL_STATIC_DRAW);
-    m_ebo = std::make_shared<Buffer<unsigned int>>(data.indices, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
-    
-    m_vao = new VAO();
-    // 更新布局字符串：3f (pos) + 3f (normal) + 2f (tex)
-    m_vao->addVBO(*m_vbo, "3f 3f 2f", GL_FALSE);
-    m_vao->addEBO(*m_ebo);
-    
-    m_indexCount = data.indices.size();
+    // 单位半径球体，半径由模型矩阵缩放（无头模式没有几何缓存）
+    if (m_engine->headless) {
+        m_vao = nullptr;
+        m_indexCount = 0;
+        return;
+    }
+    m_mesh = m_engine->meshCache->getSphere(36, 18);
+    m_vao = m_mesh->vao;
+    m_indexCount = m_mesh->indexCount;
 }
 
 void Sphere::update(float deltaTime) {
@@ -45,13 +44,8 @@ void Sphere::render() const {
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, m_texture);
     
-    // 计算并设置 Model 矩阵，使用父类的变换信息
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, m_position);
-    model = model * glm::mat4_cast(m_rotation);
-    model = glm::scale(model, m_scale);
-    
-    m_shader->setMat4("uModel", model);
+    // 设置 Model 矩阵，使用父类的变换信息
+    m_shader->setMat4(m_modelLoc, getModelMatrix());
     
     // 绘制
     m_vao->draw(GL_TRIANGLES, m_indexCount);
@@ -59,6 +53,25 @@ void Sphere::render() const {
     m_shader->end();
 }
 
+AABB Sphere::getWorldBounds() const {
+    // 单位半径网格，缩放即半径，与旋转无关
+    return AABB(m_position - m_scale, m_position + m_scale);
+}
+
+void Sphere::submit(RenderQueue& queue, const glm::mat4& model) const {
+    if (!m_shader) return;
+
+    DrawPacket packet;
+    packet.shader = m_shader;
+    packet.textures[0] = m_texture;
+    packet.vao = m_vao;
+    packet.count = static_cast<GLsizei>(m_indexCount);
+    packet.modelLoc = m_modelLoc;
+    packet.model = model;
+    packet.instanceable = true;
+    queue.submit(packet);
+}
+
 bool Sphere::collideWith(const Object& other) const {
     // 简单的球体碰撞检测占位符
     // 如果使用物理引擎，由物理引擎处理碰撞
@@ -68,8 +81,7 @@ bool Sphere::collideWith(const Object& other) const {
 void Sphere::applyForce(const glm::vec3& force) {
     // 如果有物理刚体，施加力
     if (m_rigidBody) {
-        rp3d::Vector3 rp3dForce(force.x, force.y, force.z);
-        m_rigidBody->applyWorldForceAtCenterOfMass(rp3dForce);
+        applyPhysicsForce(force);
     }
     // 如果没有物理体，什么也不做
 }
@@ -6,6 +6,7 @@
 #include "../../glFrameWork/buffers.h"
 #include "../../glFrameWork/shader.h"
 #include "../../glFrameWork/texture.h"
+#include "../meshCache.h"
 
 class Sphere : public Object {
 public:
@@ -19,6 +20,8 @@ public:
 
     void update(float deltaTime) override;
     void render() const override;
+    void submit(RenderQueue& queue, const glm::mat4& model) const override;
+    AABB getWorldBounds() const override;
     bool collideWith(const Object& other) const override;
 
     // 实现 applyForce
@@ -27,14 +30,12 @@ public:
 private:
     float m_radius;
     Shader* m_shader;
-    VAO* m_vao;
+    UniformHandle m_modelLoc;  // 预解析的 uModel 位置
+    std::shared_ptr<MeshCache::Mesh> m_mesh;  // 共享几何（相同细分的 Sphere 共用）
+    VAO* m_vao;                               // m_mesh->vao，不拥有
     GLuint m_texture;
     size_t m_indexCount;
 
-    // Keep buffers alive
-    std::shared_ptr<Buffer<float>> m_vbo;
-    std::shared_ptr<Buffer<unsigned int>> m_ebo;
-
     void initMesh();
 };
 
@@ -0,0 +1,227 @@
+﻿#include "occlusionCuller.h"
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <cmath>
+
+namespace {
+    constexpr float NEAR_EPSILON = 1e-5f;
+
+    // 到近平面（z = -w）的有向距离，>= 0 表示在近平面之前
+    float nearDistance(const glm::vec4& clip) {
+        return clip.z + clip.w;
+    }
+}
+
+OcclusionCuller::OcclusionCuller(int width, int height) {
+    m_width = ((std::max(width, TILE_SIZE) + TILE_SIZE - 1) / TILE_SIZE) * TILE_SIZE;
+    m_height = ((std::max(height, TILE_SIZE) + TILE_SIZE - 1) / TILE_SIZE) * TILE_SIZE;
+    m_tilesX = m_width / TILE_SIZE;
+    m_tilesY = m_height / TILE_SIZE;
+
+    m_depth.assign(static_cast<size_t>(m_width) * m_height, 1.0f);
+    m_tileMaxDepth.assign(static_cast<size_t>(m_tilesX) * m_tilesY, 1.0f);
+    m_bandIndices.resize(m_tilesY);
+    std::iota(m_bandIndices.begin(), m_bandIndices.end(), 0);
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjection) {
+    m_viewProjection = viewProjection;
+    m_worldTriangles.clear();
+    m_screenTriangles.clear();
+    m_stats = Stats{};
+    std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    std::fill(m_tileMaxDepth.begin(), m_tileMaxDepth.end(), 1.0f);
+}
+
+void OcclusionCuller::addOccluder(const std::vector<glm::vec3>& triangles) {
+    m_worldTriangles.insert(m_worldTriangles.end(), triangles.begin(), triangles.end());
+}
+
+glm::vec3 OcclusionCuller::toScreen(const glm::vec4& clip) const {
+    const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+    return glm::vec3((ndc.x * 0.5f + 0.5f) * m_width,
+                     (ndc.y * 0.5f + 0.5f) * m_height,
+                     ndc.z * 0.5f + 0.5f);
+}
+
+void OcclusionCuller::transformTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    const glm::vec4 clip[3] = {
+        m_viewProjection * glm::vec4(a, 1.0f),
+        m_viewProjection * glm::vec4(b, 1.0f),
+        m_viewProjection * glm::vec4(c, 1.0f)
+    };
+
+    // 近平面裁剪（Sutherland-Hodgman，单平面最多得到 4 个顶点）
+    glm::vec4 polygon[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i) {
+        const glm::vec4& current = clip[i];
+        const glm::vec4& next = clip[(i + 1) % 3];
+        const float dCurrent = nearDistance(current);
+        const float dNext = nearDistance(next);
+
+        if (dCurrent >= 0.0f) polygon[count++] = current;
+        if ((dCurrent >= 0.0f) != (dNext >= 0.0f)) {
+            const float t = dCurrent / (dCurrent - dNext);
+            polygon[count++] = current + (next - current) * t;
+        }
+    }
+    if (count < 3) return;
+
+    // 扇形三角化
+    for (int i = 1; i + 1 < count; ++i) {
+        ScreenTriangle tri;
+        const glm::vec4* verts[3] = { &polygon[0], &polygon[i], &polygon[i + 1] };
+        bool valid = true;
+        for (int k = 0; k < 3; ++k) {
+            if (verts[k]->w <= NEAR_EPSILON) { valid = false; break; }
+            tri.v[k] = toScreen(*verts[k]);
+        }
+        if (!valid) continue;
+
+        tri.minY = std::min({ tri.v[0].y, tri.v[1].y, tri.v[2].y });
+        tri.maxY = std::max({ tri.v[0].y, tri.v[1].y, tri.v[2].y });
+        const float minX = std::min({ tri.v[0].x, tri.v[1].x, tri.v[2].x });
+        const float maxX = std::max({ tri.v[0].x, tri.v[1].x, tri.v[2].x });
+        if (tri.maxY < 0.0f || tri.minY >= m_height || maxX < 0.0f || minX >= m_width) continue;
+
+        m_screenTriangles.push_back(tri);
+    }
+}
+
+void OcclusionCuller::rasterize() {
+    for (size_t i = 0; i + 2 < m_worldTriangles.size(); i += 3) {
+        transformTriangle(m_worldTriangles[i], m_worldTriangles[i + 1], m_worldTriangles[i + 2]);
+    }
+    m_stats.occluderTriangles = m_screenTriangles.size();
+    if (m_screenTriangles.empty()) return;
+
+    // 每个条带只写自己的像素行和瓦片行，可以无锁并行
+    std::for_each(std::execution::par, m_bandIndices.begin(), m_bandIndices.end(),
+        [this](int tileRow) { rasterizeBand(tileRow); });
+}
+
+void OcclusionCuller::rasterizeBand(int tileRow) {
+    const int bandMinY = tileRow * TILE_SIZE;
+    const int bandMaxY = bandMinY + TILE_SIZE - 1;
+
+    for (const ScreenTriangle& tri : m_screenTriangles) {
+        if (tri.maxY < bandMinY || tri.minY > bandMaxY + 1) continue;
+
+        const glm::vec3& v0 = tri.v[0];
+        const glm::vec3& v1 = tri.v[1];
+        const glm::vec3& v2 = tri.v[2];
+
+        float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (std::abs(area) < 1e-8f) continue;
+        const float sign = area > 0.0f ? 1.0f : -1.0f;  // 统一两种绕序
+        const float invArea = 1.0f / (area * sign);
+
+        const int minX = std::max(0, static_cast<int>(std::floor(std::min({ v0.x, v1.x, v2.x }))));
+        const int maxX = std::min(m_width - 1, static_cast<int>(std::ceil(std::max({ v0.x, v1.x, v2.x }))));
+        const int minY = std::max(bandMinY, static_cast<int>(std::floor(tri.minY)));
+        const int maxY = std::min(bandMaxY, static_cast<int>(std::ceil(tri.maxY)));
+
+        // 边函数 E(x, y) = A * x + B * y + C，沿 x 方向增量为 A
+        const float a0 = (v1.y - v2.y) * sign, b0 = (v2.x - v1.x) * sign;
+        const float a1 = (v2.y - v0.y) * sign, b1 = (v0.x - v2.x) * sign;
+        const float a2 = (v0.y - v1.y) * sign, b2 = (v1.x - v0.x) * sign;
+        const float c0 = (v1.x * v2.y - v2.x * v1.y) * sign;
+        const float c1 = (v2.x * v0.y - v0.x * v2.y) * sign;
+        const float c2 = (v0.x * v1.y - v1.x * v0.y) * sign;
+
+        // 保守覆盖：边函数在像素中心的值减去半个像素内的最大降幅仍 >= 0，即像素四角都在三角形内
+        const float o0 = 0.5f * (std::abs(a0) + std::abs(b0));
+        const float o1 = 0.5f * (std::abs(a1) + std::abs(b1));
+        const float o2 = 0.5f * (std::abs(a2) + std::abs(b2));
+        // 深度在屏幕空间线性，像素内最远深度 = 中心深度 + 半个像素内的最大增幅
+        const float dzdx = (a0 * v0.z + a1 * v1.z + a2 * v2.z) * invArea;
+        const float dzdy = (b0 * v0.z + b1 * v1.z + b2 * v2.z) * invArea;
+        const float depthSlope = 0.5f * (std::abs(dzdx) + std::abs(dzdy));
+
+        for (int y = minY; y <= maxY; ++y) {
+            const float py = y + 0.5f;
+            const float startX = minX + 0.5f;
+            float w0 = a0 * startX + b0 * py + c0;
+            float w1 = a1 * startX + b1 * py + c1;
+            float w2 = a2 * startX + b2 * py + c2;
+            float* row = &m_depth[static_cast<size_t>(y) * m_width];
+
+            for (int x = minX; x <= maxX; ++x) {
+                if (w0 >= o0 && w1 >= o1 && w2 >= o2) {
+                    const float depth = (w0 * v0.z + w1 * v1.z + w2 * v2.z) * invArea + depthSlope;
+                    row[x] = std::min(row[x], depth);
+                }
+                w0 += a0;
+                w1 += a1;
+                w2 += a2;
+            }
+        }
+    }
+
+    // 构建该行瓦片的最远深度
+    for (int tileX = 0; tileX < m_tilesX; ++tileX) {
+        float maxDepth = 0.0f;
+        for (int y = bandMinY; y <= bandMaxY; ++y) {
+            const float* row = &m_depth[static_cast<size_t>(y) * m_width + tileX * TILE_SIZE];
+            for (int x = 0; x < TILE_SIZE; ++x) {
+                maxDepth = std::max(maxDepth, row[x]);
+            }
+        }
+        m_tileMaxDepth[static_cast<size_t>(tileRow) * m_tilesX + tileX] = maxDepth;
+    }
+}
+
+bool OcclusionCuller::isVisible(const AABB& box) {
+    ++m_stats.tested;
+    if (m_screenTriangles.empty()) return true;
+
+    // 投影 8 个角点，求屏幕矩形与最近深度
+    float minX = static_cast<float>(m_width), maxX = 0.0f;
+    float minY = static_cast<float>(m_height), maxY = 0.0f;
+    float minDepth = 1.0f;
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec3 corner((i & 1) ? box.max.x : box.min.x,
+                               (i & 2) ? box.max.y : box.min.y,
+                               (i & 4) ? box.max.z : box.min.z);
+        const glm::vec4 clip = m_viewProjection * glm::vec4(corner, 1.0f);
+        if (clip.w <= NEAR_EPSILON || nearDistance(clip) < 0.0f) {
+            return true;  // 跨越近平面，保守地视为可见
+        }
+        const glm::vec3 screen = toScreen(clip);
+        minX = std::min(minX, screen.x);
+        maxX = std::max(maxX, screen.x);
+        minY = std::min(minY, screen.y);
+        maxY = std::max(maxY, screen.y);
+        minDepth = std::min(minDepth, screen.z);
+    }
+
+    const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    const int x1 = std::min(m_width - 1, static_cast<int>(std::ceil(maxX)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(m_height - 1, static_cast<int>(std::ceil(maxY)));
+    if (x0 > x1 || y0 > y1) return true;  // 不在屏幕内的交给视锥剔除处理
+
+    for (int tileY = y0 / TILE_SIZE; tileY <= y1 / TILE_SIZE; ++tileY) {
+        for (int tileX = x0 / TILE_SIZE; tileX <= x1 / TILE_SIZE; ++tileX) {
+            // 瓦片内最远的遮挡深度都比物体最近点更近：整块被遮挡
+            if (m_tileMaxDepth[static_cast<size_t>(tileY) * m_tilesX + tileX] < minDepth) continue;
+
+            // 逐像素检查瓦片与矩形的重叠部分
+            const int px0 = std::max(x0, tileX * TILE_SIZE);
+            const int px1 = std::min(x1, tileX * TILE_SIZE + TILE_SIZE - 1);
+            const int py0 = std::max(y0, tileY * TILE_SIZE);
+            const int py1 = std::min(y1, tileY * TILE_SIZE + TILE_SIZE - 1);
+            for (int y = py0; y <= py1; ++y) {
+                const float* row = &m_depth[static_cast<size_t>(y) * m_width];
+                for (int x = px0; x <= px1; ++x) {
+                    if (row[x] >= minDepth) return true;
+                }
+            }
+        }
+    }
+
+    ++m_stats.occluded;
+    return false;
+}
@@ -0,0 +1,107 @@
+﻿#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include "bounds.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * @brief CPU 软件遮挡剔除
+ *
+ * 每帧把标记为遮挡体的大型物体（墙、地板）的三角形光栅化到低分辨率深度缓冲，
+ * 再把候选物体的包围盒投影到屏幕，与深度缓冲比较：覆盖区域内所有像素都比包围盒最近点更近时判定为被遮挡。
+ *
+ * - 深度缓冲按行连续存放，宽度为 TILE_SIZE 的倍数，内层循环可被编译器向量化
+ * - 每个 TILE_SIZE x TILE_SIZE 瓦片额外记录最远深度（层次深度），整块被遮挡时无需逐像素比较
+ * - 光栅化按瓦片行划分为水平条带，用 std::execution::par 在工作线程上并行，条带互不重叠无需加锁
+ * - 遮挡体只写入被三角形完全覆盖的像素，深度取像素四角中最远的值，避免在轮廓处多遮挡
+ * - 完全不依赖 OpenGL，可在无窗口环境下运行
+ *
+ * 判定是保守的：包围盒跨越近平面、或投影区域内有任何像素未被更近的遮挡体覆盖，都视为可见。
+ */
+class OcclusionCuller {
+public:
+    static constexpr int TILE_SIZE = 8;  // 层次深度瓦片边长（像素）
+
+    /**
+     * @brief 统计（最近一帧）
+     */
+    struct Stats {
+        size_t occluderTriangles{ 0 };  // 光栅化的遮挡三角形数（裁剪后）
+        size_t tested{ 0 };             // 测试的候选数量
+        size_t occluded{ 0 };           // 被判定遮挡的数量
+    };
+
+    /**
+     * @param width 深度缓冲宽度（向上取整到 TILE_SIZE 的倍数）
+     * @param height 深度缓冲高度（向上取整到 TILE_SIZE 的倍数）
+     */
+    OcclusionCuller(int width = 256, int height = 128);
+
+    /**
+     * @brief 开始新的一帧：清空深度缓冲与遮挡体
+     * @param viewProjection projection * view
+     */
+    void beginFrame(const glm::mat4& viewProjection);
+
+    /**
+     * @brief 添加遮挡体三角形（世界空间，每 3 个顶点一个三角形）
+     */
+    void addOccluder(const std::vector<glm::vec3>& triangles);
+
+    /**
+     * @brief 光栅化本帧所有遮挡体并构建层次深度
+     */
+    void rasterize();
+
+    /**
+     * @brief 测试包围盒是否可能可见
+     * @return false 表示一定被遮挡
+     */
+    bool isVisible(const AABB& box);
+
+    /**
+     * @brief 获取深度缓冲（0 为近平面，1 为远平面），用于调试
+     */
+    const std::vector<float>& getDepthBuffer() const { return m_depth; }
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    struct ScreenTriangle {
+        glm::vec3 v[3];  // 屏幕像素坐标 x, y 与深度 z（0~1）
+        float minY;
+        float maxY;
+    };
+
+    /**
+     * @brief 把世界空间三角形变换到屏幕，跨越近平面时裁剪（最多生成 2 个三角形）
+     */
+    void transformTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+    /**
+     * @brief 光栅化一个条带（瓦片行）内的所有三角形，并更新该行瓦片的最远深度
+     */
+    void rasterizeBand(int tileRow);
+
+    /**
+     * @brief 裁剪空间坐标转屏幕坐标
+     */
+    glm::vec3 toScreen(const glm::vec4& clip) const;
+
+    int m_width;
+    int m_height;
+    int m_tilesX;
+    int m_tilesY;
+    glm::mat4 m_viewProjection{ 1.0f };
+    std::vector<float> m_depth;             // 逐像素深度（行主序）
+    std::vector<float> m_tileMaxDepth;      // 每个瓦片的最远深度
+    std::vector<glm::vec3> m_worldTriangles;  // 本帧遮挡体三角形（世界空间）
+    std::vector<ScreenTriangle> m_screenTriangles;
+    std::vector<int> m_bandIndices;         // 0..m_tilesY-1，用于并行遍历
+    Stats m_stats;
+};
+
+#endif // OCCLUSION_CULLER_H
@@ -0,0 +1,110 @@
+﻿#ifndef PHYSICS_COMMAND_QUEUE_H
+#define PHYSICS_COMMAND_QUEUE_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "object/object.h"
+
+/**
+ * @brief 游戏逻辑发给物理世界的命令（流水线物理模式下在同步点统一执行）
+ */
+struct PhysicsCommand {
+    enum class Type : uint8_t {
+        APPLY_FORCE,    // 在质心施加世界空间力
+        SET_TRANSFORM,  // 设置刚体位置与旋转
+        SET_VELOCITY    // 设置刚体线速度
+    };
+
+    Type type{ Type::APPLY_FORCE };
+    ObjectHandle target;                             // 目标对象（执行时对象已移除则忽略）
+    glm::vec3 vector{ 0.0f };                        // 力 / 位置 / 速度
+    glm::quat rotation{ 1.0f, 0.0f, 0.0f, 0.0f };   // 旋转（仅 SET_TRANSFORM）
+};
+
+/**
+ * @brief 有界无锁多生产者多消费者队列（每个单元带序号，生产者/消费者各用一个原子游标）
+ *
+ * 任意线程可 push，物理同步点 pop；队列满时 push 返回 false，不会阻塞。
+ */
+class PhysicsCommandQueue {
+public:
+    /**
+     * @param capacity 容量，向上取整为 2 的幂
+     */
+    explicit PhysicsCommandQueue(size_t capacity = 8192) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        m_mask = size - 1;
+        m_cells = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    PhysicsCommandQueue(const PhysicsCommandQueue&) = delete;
+    PhysicsCommandQueue& operator=(const PhysicsCommandQueue&) = delete;
+
+    /**
+     * @brief 入队
+     * @return 队列已满时返回 false
+     */
+    bool push(const PhysicsCommand& command) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.command = command;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief 出队
+     * @return 队列为空时返回 false
+     */
+    bool pop(PhysicsCommand& command) {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    command = cell.command;
+                    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{ 0 };
+        PhysicsCommand command;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask{ 0 };
+    alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };  // 生产者游标（独占缓存行，避免与消费者伪共享）
+    alignas(64) std::atomic<size_t> m_dequeuePos{ 0 };  // 消费者游标
+};
+
+#endif // PHYSICS_COMMAND_QUEUE_H
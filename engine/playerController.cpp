@@ -3,6 +3,7 @@
 #include "camera.h"
 #include "object/slime/slime.h"
 #include "object/slime/slimeController.h"
+#include "inputRecorder.h"
 #include "../application/application.h"
 #include <iostream>
 
@@ -49,6 +50,16 @@ void PlayerController::update(float deltaTime) {
         m_slimeController->update(deltaTime);
     }
 
+    // 回放：施加日志中本帧的力，不读键盘
+    InputRecorder* recorder = m_engine->inputRecorder;
+    if (recorder && recorder->isReplaying()) {
+        const InputRecorder::Frame& frame = recorder->getReplayFrame();
+        if (frame.hasPlayerForce) {
+            applyMoveForce(frame.playerForce);
+        }
+        return;
+    }
+
     if (m_controlMode == ControlMode::CAMERA) {
         updateCameraControl(deltaTime);
     } else if (m_controlMode == ControlMode::OBJECT) {
@@ -120,15 +131,23 @@ void PlayerController::updateObjectControl(float deltaTime) {
     // 归一化移动方向
     if (glm::length(moveDirection) > 0.001f) {
         moveDirection = glm::normalize(moveDirection);
+        applyMoveForce(moveDirection * m_moveForce);
+    }
+}
 
-        // 如果是史莱姆，使用 SlimeController 施加力到主集群
-        if (m_slimeController) {
-            glm::vec3 force = moveDirection * m_moveForce;
-            m_slimeController->applyForceToMainCluster(force);
-        } else {
-            // 普通对象，施加全局力
-            glm::vec3 force = moveDirection * m_moveForce;
-            m_controlledObject->applyForce(force);
-        }
+void PlayerController::applyMoveForce(const glm::vec3& force) {
+    if (!m_controlledObject) return;
+
+    // 如果是史莱姆，使用 SlimeController 施加力到主集群
+    if (m_slimeController) {
+        m_slimeController->applyForceToMainCluster(force);
+    } else {
+        // 普通对象，施加全局力
+        m_controlledObject->applyForce(force);
+    }
+
+    InputRecorder* recorder = m_engine->inputRecorder;
+    if (recorder && recorder->isRecording()) {
+        recorder->recordPlayerForce(force);
     }
 }
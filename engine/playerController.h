@@ -59,6 +59,7 @@ private:
     // 内部更新方法
     void updateCameraControl(float deltaTime);
     void updateObjectControl(float deltaTime);
+    void applyMoveForce(const glm::vec3& force);  // 施加移动力（录制时记入输入日志）
 };
 
 #endif // PLAYER_CONTROLLER_H
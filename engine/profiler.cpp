@@ -0,0 +1,396 @@
+﻿#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    const auto s_epoch = std::chrono::steady_clock::now();
+    thread_local void* t_threadBuffer = nullptr;  // 当前线程的 ThreadBuffer
+    thread_local bool t_threadBufferReleased = false;  // 平凡类型，线程退出归还缓冲后仍可安全读取
+
+    bool sameName(const char* a, const char* b) {
+        if (a == b) return true;
+        if (!a || !b) return false;
+        return std::strcmp(a, b) == 0;
+    }
+}
+
+Profiler& Profiler::instance() {
+    // 有意不析构：线程池线程可能在静态对象析构之后仍结束区段
+    static Profiler* profiler = new Profiler();
+    return *profiler;
+}
+
+uint64_t Profiler::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_epoch).count());
+}
+
+Profiler::ThreadBuffer* Profiler::threadBuffer() {
+    if (!t_threadBuffer) {
+        if (t_threadBufferReleased) return nullptr;
+        thread_local ThreadBufferOwner owner;  // 线程退出时归还缓冲
+
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        // 优先复用已退出线程的缓冲（重启的物理线程等），避免每个新线程再占一份环形缓冲
+        auto it = std::find_if(m_threads.begin(), m_threads.end(),
+            [](const std::unique_ptr<ThreadBuffer>& b) { return b->available; });
+        ThreadBuffer* buffer = nullptr;
+        if (it != m_threads.end()) {
+            buffer = it->get();
+            buffer->available = false;
+            buffer->retired.store(false, std::memory_order_relaxed);
+            buffer->depth = 0;
+            buffer->hasPendingRun.store(false, std::memory_order_relaxed);
+        } else {
+            m_threads.push_back(std::make_unique<ThreadBuffer>());
+            buffer = m_threads.back().get();
+            buffer->events.resize(THREAD_BUFFER_SIZE);
+            buffer->threadId = static_cast<uint32_t>(m_threads.size() - 1);
+        }
+        buffer->threadName = "Worker " + std::to_string(buffer->threadId);
+        owner.buffer = buffer;
+        t_threadBuffer = buffer;
+    }
+    return static_cast<ThreadBuffer*>(t_threadBuffer);
+}
+
+Profiler::ThreadBufferOwner::~ThreadBufferOwner() {
+    t_threadBuffer = nullptr;
+    t_threadBufferReleased = true;
+    if (!buffer) return;
+    {
+        std::lock_guard<std::mutex> lock(buffer->runMutex);
+        if (buffer->hasPendingRun.load(std::memory_order_relaxed)) {
+            buffer->publish(buffer->pendingRun);
+            buffer->hasPendingRun.store(false, std::memory_order_relaxed);
+        }
+    }
+    buffer->retired.store(true, std::memory_order_release);
+}
+
+void Profiler::setEnabled(bool enabled) {
+    m_alwaysEnabled = enabled;
+    updateEnabled();
+}
+
+void Profiler::setReportInterval(int frames) {
+    m_reportInterval = frames;
+    updateEnabled();
+}
+
+void Profiler::updateEnabled() {
+    m_enabled.store(m_alwaysEnabled || m_reportInterval > 0 || m_captureFramesLeft > 0, std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer* buffer = threadBuffer();
+    if (!buffer) return;
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    buffer->threadName = name;
+}
+
+void Profiler::pushZone(const char* name, uint64_t& startNs, uint32_t& depth, const char*& parent) {
+    ThreadBuffer* bufferPtr = threadBuffer();
+    if (!bufferPtr) return;
+    ThreadBuffer& buffer = *bufferPtr;
+    depth = buffer.depth;
+    parent = depth > 0 ? buffer.zoneStack[std::min(depth, MAX_DEPTH) - 1] : nullptr;
+    if (buffer.depth < MAX_DEPTH) {
+        buffer.zoneStack[buffer.depth] = name;
+    }
+    ++buffer.depth;
+    startNs = nowNs();
+}
+
+void Profiler::ThreadBuffer::publish(const Event& event) {
+    const uint64_t index = writeIndex.load(std::memory_order_relaxed);
+    events[index & (THREAD_BUFFER_SIZE - 1)] = event;
+    writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::popZone(const char* name, const char* parent, uint64_t startNs, uint32_t depth, bool parallel) {
+    const uint64_t endNs = nowNs();
+    ThreadBuffer* bufferPtr = threadBuffer();
+    if (!bufferPtr) return;
+    ThreadBuffer& buffer = *bufferPtr;
+    buffer.depth = depth;
+
+    if (parallel) {
+        // 与上一段同名且间隔很短：延长该段（该段可能已被 endFrame 取走，此时另起一段）
+        std::lock_guard<std::mutex> lock(buffer.runMutex);
+        Event& run = buffer.pendingRun;
+        const bool hasRun = buffer.hasPendingRun.load(std::memory_order_relaxed);
+        if (hasRun && run.name == name && run.depth == depth && startNs - run.endNs < PARALLEL_MERGE_GAP_NS) {
+            run.endNs = endNs;
+            ++run.count;
+            return;
+        }
+        if (hasRun) buffer.publish(run);
+        run = Event{ name, parent, startNs, endNs, depth, 1 };
+        buffer.hasPendingRun.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    // 只有本线程会置位，未置位时无需加锁
+    if (buffer.hasPendingRun.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(buffer.runMutex);
+        if (buffer.hasPendingRun.load(std::memory_order_relaxed)) {
+            buffer.publish(buffer.pendingRun);
+            buffer.hasPendingRun.store(false, std::memory_order_relaxed);
+        }
+    }
+    buffer.publish(Event{ name, parent, startNs, endNs, depth, 1 });
+}
+
+void Profiler::drainThread(ThreadBuffer& buffer, std::vector<ZoneAccumulator>& zones) {
+    const uint64_t end = buffer.writeIndex.load(std::memory_order_acquire);
+    uint64_t begin = buffer.readIndex;
+    // 生产者领先超过缓冲大小时，最旧的事件已被覆盖
+    if (end - begin > THREAD_BUFFER_SIZE) {
+        m_droppedEvents += end - begin - THREAD_BUFFER_SIZE;
+        begin = end - THREAD_BUFFER_SIZE;
+    }
+
+    // 先拷出，再重读写索引：拷贝期间生产者绕回覆盖的槽位可能被撕裂，丢弃这些事件
+    m_drainEvents.clear();
+    for (uint64_t i = begin; i < end; ++i) {
+        m_drainEvents.push_back(buffer.events[i & (THREAD_BUFFER_SIZE - 1)]);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t after = buffer.writeIndex.load(std::memory_order_relaxed);
+    // 生产者正在写入下标 after 的事件，它占用的是事件 after - THREAD_BUFFER_SIZE 的槽位
+    const uint64_t firstIntact = after >= THREAD_BUFFER_SIZE ? after - THREAD_BUFFER_SIZE + 1 : 0;
+    const size_t skip = firstIntact > begin ? static_cast<size_t>(std::min(firstIntact, end) - begin) : 0;
+    m_droppedEvents += skip;
+
+    for (size_t k = skip; k < m_drainEvents.size(); ++k) {
+        accumulateEvent(m_drainEvents[k], buffer.threadId, zones);
+    }
+    buffer.readIndex = end;
+}
+
+void Profiler::takePendingRun(ThreadBuffer& buffer, std::vector<ZoneAccumulator>& zones) {
+    if (!buffer.hasPendingRun.load(std::memory_order_relaxed)) return;
+    // 线程可能在下一帧才记录新区段（或一直空闲），不取走的话这一段会被计入之后的帧
+    Event run;
+    {
+        std::lock_guard<std::mutex> lock(buffer.runMutex);
+        if (!buffer.hasPendingRun.load(std::memory_order_relaxed)) return;
+        run = buffer.pendingRun;
+        buffer.hasPendingRun.store(false, std::memory_order_relaxed);
+    }
+    accumulateEvent(run, buffer.threadId, zones);
+}
+
+void Profiler::accumulateEvent(const Event& e, uint32_t threadId, std::vector<ZoneAccumulator>& zones) {
+    auto it = std::find_if(zones.begin(), zones.end(), [&e](const ZoneAccumulator& z) {
+        return z.depth == e.depth && sameName(z.name, e.name) && sameName(z.parent, e.parent);
+    });
+    if (it == zones.end()) {
+        zones.push_back({ e.name, e.parent, e.depth, 0, 0, 0 });
+        it = zones.end() - 1;
+    }
+    it->totalNs += e.endNs - e.startNs;
+    it->calls += e.count;
+    it->threadMask |= 1ull << (threadId & 63);
+
+    if (m_captureFramesLeft > 0) {
+        m_captureEvents.push_back({ e, threadId });
+    }
+}
+
+void Profiler::endFrame() {
+    m_frameZones.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        for (auto& buffer : m_threads) {
+            if (buffer->available) continue;
+            const bool retired = buffer->retired.load(std::memory_order_acquire);
+            takePendingRun(*buffer, m_frameZones);
+            drainThread(*buffer, m_frameZones);
+            if (retired) buffer->available = true;  // 所属线程已退出，事件已全部读完
+        }
+    }
+    orderZones(m_frameZones, m_lastFrame);
+
+    if (m_captureFramesLeft > 0) {
+        m_captureFrameMarks.push_back(nowNs());
+        if (--m_captureFramesLeft == 0) {
+            writeCapture();
+            updateEnabled();
+        }
+    }
+
+    if (m_reportInterval <= 0) {
+        m_reportZones.clear();
+        m_reportFrames = 0;
+        return;
+    }
+
+    // 累计到报告区间
+    for (const ZoneStats& zone : m_lastFrame) {
+        auto it = std::find_if(m_reportZones.begin(), m_reportZones.end(), [&zone](const ZoneStats& z) {
+            return z.depth == zone.depth && z.name == zone.name && z.parent == zone.parent;
+        });
+        if (it == m_reportZones.end()) {
+            m_reportZones.push_back(zone);
+        } else {
+            it->totalMs += zone.totalMs;
+            it->calls += zone.calls;
+            it->threads = std::max(it->threads, zone.threads);
+        }
+    }
+    if (++m_reportFrames >= m_reportInterval) {
+        logReport();
+        m_reportZones.clear();
+        m_reportFrames = 0;
+    }
+}
+
+void Profiler::orderZones(std::vector<ZoneAccumulator>& zones, std::vector<ZoneStats>& out) const {
+    out.clear();
+    std::sort(zones.begin(), zones.end(), [](const ZoneAccumulator& a, const ZoneAccumulator& b) {
+        return a.totalNs > b.totalNs;
+    });
+
+    // 深度优先：每个区段后紧跟它的子区段（同层按耗时降序）
+    std::vector<bool> emitted(zones.size(), false);
+    auto emit = [&](auto& self, size_t index) -> void {
+        const ZoneAccumulator& z = zones[index];
+        emitted[index] = true;
+        ZoneStats stats;
+        stats.name = z.name;
+        stats.parent = z.parent ? z.parent : "";
+        stats.depth = z.depth;
+        stats.totalMs = z.totalNs / 1.0e6;
+        stats.calls = z.calls;
+        for (uint64_t mask = z.threadMask; mask; mask &= mask - 1) ++stats.threads;
+        out.push_back(std::move(stats));
+        for (size_t i = 0; i < zones.size(); ++i) {
+            if (!emitted[i] && zones[i].depth == z.depth + 1 && sameName(zones[i].parent, z.name)) {
+                self(self, i);
+            }
+        }
+    };
+    for (size_t i = 0; i < zones.size(); ++i) {
+        if (!emitted[i] && zones[i].depth == 0) emit(emit, i);
+    }
+    // 父区段跨帧（本帧未结束）的孤立区段放在最后
+    for (size_t i = 0; i < zones.size(); ++i) {
+        if (!emitted[i]) emit(emit, i);
+    }
+}
+
+void Profiler::logReport() {
+    std::cout << "[Profiler] 最近 " << m_reportFrames << " 帧平均（毫秒/帧）" << std::endl;
+    for (const ZoneStats& zone : m_reportZones) {
+        std::cout << "[Profiler] " << std::string(zone.depth * 2, ' ')
+                  << std::left << std::setw(std::max(1, 36 - static_cast<int>(zone.depth) * 2)) << zone.name << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(9) << zone.totalMs / m_reportFrames
+                  << "  x" << std::setprecision(1) << static_cast<double>(zone.calls) / m_reportFrames;
+        if (zone.threads > 1) {
+            std::cout << "  (" << zone.threads << " 线程)";
+        }
+        std::cout << std::endl;
+    }
+    if (m_droppedEvents > 0) {
+        std::cout << "[Profiler] 丢失事件：" << m_droppedEvents << std::endl;
+    }
+}
+
+void Profiler::beginCapture(int frames, const std::string& path) {
+    if (frames <= 0) return;
+    m_captureFramesLeft = frames;
+    updateEnabled();
+    m_captureFrameCount = frames;
+    m_capturePath = path;
+    m_captureEvents.clear();
+    m_captureFrameMarks.clear();
+    std::cout << "[Profiler] 开始录制 " << frames << " 帧 -> " << path << std::endl;
+}
+
+namespace {
+    // 写出 JSON 字符串（转义引号、反斜杠与控制字符）
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            switch (*c) {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(*c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", *c);
+                        out << buf;
+                    } else {
+                        out << *c;
+                    }
+            }
+        }
+        out << '"';
+    }
+}
+
+void Profiler::writeCapture() {
+    std::ofstream out(m_capturePath, std::ios::binary);
+    if (!out) {
+        std::cout << "[Profiler] 无法写入 " << m_capturePath << std::endl;
+        m_captureEvents.clear();
+        return;
+    }
+
+    // Chrome trace-event 格式：完整事件 ph="X"，时间单位微秒
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << std::fixed << std::setprecision(3);
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) out << ",\n";
+        first = false;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        for (const auto& buffer : m_threads) {
+            separator();
+            out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+            writeJsonString(out, buffer->threadName.c_str());
+            out << "}}";
+            separator();
+            out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":" << buffer->threadId << "}}";
+        }
+    }
+
+    for (const CapturedEvent& captured : m_captureEvents) {
+        const Event& e = captured.event;
+        separator();
+        out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << captured.threadId << ",\"name\":";
+        writeJsonString(out, e.name);
+        out << ",\"ts\":" << e.startNs / 1000.0 << ",\"dur\":" << (e.endNs - e.startNs) / 1000.0;
+        if (e.count > 1) {
+            out << ",\"args\":{\"calls\":" << e.count << "}";
+        }
+        out << "}";
+    }
+
+    // 帧边界标记（全局瞬时事件）
+    for (size_t i = 0; i < m_captureFrameMarks.size(); ++i) {
+        separator();
+        out << "{\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"name\":\"Frame " << i << "\",\"ts\":"
+            << m_captureFrameMarks[i] / 1000.0 << "}";
+    }
+    out << "\n]}\n";
+
+    std::cout << "[Profiler] 录制完成：" << m_captureFrameCount << " 帧，" << m_captureEvents.size()
+              << " 个区段 -> " << m_capturePath << std::endl;
+    m_captureEvents.clear();
+    m_captureEvents.shrink_to_fit();
+    m_captureFrameMarks.clear();
+}
@@ -0,0 +1,225 @@
+﻿#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 层级作用域 CPU 性能分析器
+ *
+ * 用 PROFILE_SCOPE("名称") 在作用域内计时，作用域可以嵌套。每个线程把结束的区段写入自己的
+ * 环形事件缓冲（只有本线程写，无锁），主线程在每帧 endFrame() 时读取所有线程的新事件，
+ * 按（深度, 父区段, 名称）聚合出本帧各区段的总耗时与调用次数。
+ * 线程退出后它的缓冲在下一次 endFrame 读完后回收，供之后新建的线程复用。
+ * 区段名称必须是生命周期足够长的字符串（通常是字面量）。
+ * 并行循环体内用 PROFILE_PARALLEL_SCOPE：同一线程上紧邻的同名区段合并为一段，
+ * 逐元素调用也只产生每线程少量事件；endFrame 会取走各线程合并中的一段，区段总计入它结束所在的帧。
+ * beginCapture() 录制接下来 N 帧所有线程的区段，结束后写出 Chrome trace-event JSON
+ * （可在 Perfetto 或 chrome://tracing 中查看时间线）。
+ * 默认不计时：打开周期报告（F2）、录制（F3 / --trace-frames）或 setEnabled(true) 时才计时，
+ * 否则作用域对象只读一个原子标志，热点循环里的逐元素区段几乎没有开销。
+ * 定义 DISABLE_PROFILER 时宏展开为空。
+ */
+class Profiler {
+public:
+    static constexpr uint32_t MAX_DEPTH = 64;            // 最大嵌套深度
+    static constexpr size_t THREAD_BUFFER_SIZE = 1 << 14;  // 每线程环形缓冲事件数
+    static constexpr uint64_t PARALLEL_MERGE_GAP_NS = 20000;  // 并行区段合并的最大间隔
+
+    /**
+     * @brief 一个结束的区段
+     */
+    struct Event {
+        const char* name;     // 区段名称
+        const char* parent;   // 父区段名称（顶层为 nullptr）
+        uint64_t startNs;     // 开始时间（相对分析器启动，纳秒）
+        uint64_t endNs;       // 结束时间
+        uint32_t depth;       // 嵌套深度（顶层为 0）
+        uint32_t count;       // 合并的调用次数（普通区段为 1）
+    };
+
+    /**
+     * @brief 一帧内某个区段的聚合结果
+     */
+    struct ZoneStats {
+        std::string name;
+        std::string parent;
+        uint32_t depth{ 0 };
+        double totalMs{ 0.0 };   // 所有线程、所有调用的耗时之和
+        uint32_t calls{ 0 };     // 调用次数
+        uint32_t threads{ 0 };   // 出现该区段的线程数
+    };
+
+    static Profiler& instance();
+
+    /**
+     * @brief 常开计时（基准测试用）；关闭后仍在报告或录制期间计时
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 命名当前线程（用于报告与导出）
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * @brief 帧结束：收集所有线程的新事件并聚合为本帧结果
+     */
+    void endFrame();
+
+    /**
+     * @brief 上一帧的聚合结果（按层级深度优先排列）
+     */
+    const std::vector<ZoneStats>& getLastFrame() const { return m_lastFrame; }
+
+    /**
+     * @brief 每隔 frames 帧打印一次期间的平均耗时（0 表示不打印）
+     */
+    void setReportInterval(int frames);
+    int getReportInterval() const { return m_reportInterval; }
+
+    /**
+     * @brief 因环形缓冲被覆盖而丢失的事件数
+     */
+    uint64_t getDroppedEventCount() const { return m_droppedEvents; }
+
+    /**
+     * @brief 开始录制：接下来 frames 帧的所有区段写入 path（Chrome trace-event JSON）
+     */
+    void beginCapture(int frames, const std::string& path);
+
+    /**
+     * @brief 是否正在录制
+     */
+    bool isCapturing() const { return m_captureFramesLeft > 0; }
+
+    /**
+     * @brief 当前时间（相对分析器启动，纳秒）
+     */
+    static uint64_t nowNs();
+
+    // 由 ProfileScope 调用
+    void pushZone(const char* name, uint64_t& startNs, uint32_t& depth, const char*& parent);
+    void popZone(const char* name, const char* parent, uint64_t startNs, uint32_t depth, bool parallel);
+
+private:
+    // 每线程事件缓冲：只有所属线程写入 events 并推进 writeIndex
+    struct ThreadBuffer {
+        std::vector<Event> events;
+        std::atomic<uint64_t> writeIndex{ 0 };
+        uint64_t readIndex{ 0 };                // 只由 endFrame 所在线程使用
+        uint32_t threadId{ 0 };
+        std::string threadName;
+        const char* zoneStack[MAX_DEPTH]{};     // 当前打开的区段（嵌套）
+        uint32_t depth{ 0 };
+        std::mutex runMutex;                    // 保护 pendingRun：endFrame 会取走空闲线程上合并中的一段
+        Event pendingRun{};                     // 合并中的并行区段（尚未发布）
+        std::atomic<bool> hasPendingRun{ false };  // 只在持有 runMutex 时修改
+        std::atomic<bool> retired{ false };     // 所属线程已退出
+        bool available{ false };                // 已读完，可分配给新线程（受 m_registryMutex 保护）
+
+        void publish(const Event& event);
+    };
+
+    // 线程退出时发布未完成的合并区段并把缓冲标记为退役
+    struct ThreadBufferOwner {
+        ThreadBuffer* buffer{ nullptr };
+        ~ThreadBufferOwner();
+    };
+
+    // 录制的事件
+    struct CapturedEvent {
+        Event event;
+        uint32_t threadId;
+    };
+
+    // 区段在一帧内的累计
+    struct ZoneAccumulator {
+        const char* name;
+        const char* parent;
+        uint32_t depth;
+        uint64_t totalNs;
+        uint32_t calls;
+        uint64_t threadMask;
+    };
+
+    Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    ThreadBuffer* threadBuffer();  // 线程退出、缓冲已归还后返回 nullptr
+    void drainThread(ThreadBuffer& buffer, std::vector<ZoneAccumulator>& zones);
+    void takePendingRun(ThreadBuffer& buffer, std::vector<ZoneAccumulator>& zones);
+    void accumulateEvent(const Event& e, uint32_t threadId, std::vector<ZoneAccumulator>& zones);
+    void orderZones(std::vector<ZoneAccumulator>& zones, std::vector<ZoneStats>& out) const;
+    void logReport();
+    void updateEnabled();  // 常开、报告中或录制中时计时
+    void writeCapture();
+
+    std::atomic<bool> m_enabled{ false };
+    bool m_alwaysEnabled{ false };
+    std::mutex m_registryMutex;                             // 只在线程首次使用时加锁
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;  // 所有注册过的线程
+    std::vector<ZoneAccumulator> m_frameZones;              // 本帧累计（复用）
+    std::vector<Event> m_drainEvents;                       // 读取环形缓冲时的拷贝（复用）
+    std::vector<ZoneStats> m_lastFrame;                     // 上一帧结果
+    std::vector<ZoneStats> m_reportZones;                   // 报告区间累计
+    int m_reportInterval{ 0 };
+    int m_reportFrames{ 0 };
+    uint64_t m_droppedEvents{ 0 };
+
+    // 录制
+    int m_captureFramesLeft{ 0 };
+    int m_captureFrameCount{ 0 };
+    std::string m_capturePath;
+    std::vector<CapturedEvent> m_captureEvents;
+    std::vector<uint64_t> m_captureFrameMarks;  // 各帧结束时间
+};
+
+/**
+ * @brief RAII 区段：构造时开始计时，析构时写入事件
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name, bool parallel = false) : m_name(name), m_parallel(parallel) {
+        m_active = Profiler::instance().isEnabled();
+        if (m_active) {
+            Profiler::instance().pushZone(m_name, m_startNs, m_depth, m_parent);
+        }
+    }
+    ~ProfileScope() {
+        if (m_active) {
+            Profiler::instance().popZone(m_name, m_parent, m_startNs, m_depth, m_parallel);
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_parent{ nullptr };
+    uint64_t m_startNs{ 0 };
+    uint32_t m_depth{ 0 };
+    bool m_parallel;
+    bool m_active{ false };
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifndef DISABLE_PROFILER
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_PARALLEL_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name, true)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_PARALLEL_SCOPE(name) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,140 @@
+﻿#include "renderQueue.h"
+#include "object/object.h"
+#include "instanceBatcher.h"
+#include "../glFrameWork/buffers.h"
+#include <algorithm>
+
+void RenderQueue::clear() {
+    m_packets.clear();
+    m_sortEntries.clear();
+    m_customObjects.clear();
+}
+
+void RenderQueue::submit(const DrawPacket& packet) {
+    if (!packet.shader || !packet.vao) return;
+    m_sortEntries.push_back({ makeSortKey(packet), static_cast<uint32_t>(m_packets.size()) });
+    m_packets.push_back(packet);
+}
+
+void RenderQueue::submitCustom(const Object* object) {
+    if (object) {
+        m_customObjects.push_back(object);
+    }
+}
+
+uint64_t RenderQueue::makeSortKey(const DrawPacket& packet) {
+    // GL 对象名是从 1 开始的小整数，16 位足够区分；即使截断碰撞也只影响合批效果，不影响正确性
+    const uint64_t shader = packet.shader->getProgramID() & 0xFFFF;
+    const uint64_t texture0 = packet.textures[0] & 0xFFFF;
+    const uint64_t texture1 = packet.textures[1] & 0xFFFF;
+    const uint64_t vao = packet.vao->id() & 0xFFFF;
+    return (shader << 48) | (texture0 << 32) | (texture1 << 16) | vao;
+}
+
+bool RenderQueue::canBatch(const DrawPacket& a, const DrawPacket& b) {
+    return a.instanceable && b.instanceable &&
+        a.shader == b.shader && a.vao == b.vao &&
+        a.textures[0] == b.textures[0] && a.textures[1] == b.textures[1] &&
+        a.mode == b.mode && a.count == b.count;
+}
+
+void RenderQueue::buildBatches() {
+    m_batches.clear();
+    if (m_batcher) m_batcher->begin();
+
+    const uint32_t total = static_cast<uint32_t>(m_sortEntries.size());
+    uint32_t first = 0;
+    while (first < total) {
+        // 排序后相同网格/材质的包相邻，向后扩展到第一个不能合并的包
+        const DrawPacket& head = m_packets[m_sortEntries[first].index];
+        uint32_t last = first + 1;
+        while (last < total && canBatch(head, m_packets[m_sortEntries[last].index])) {
+            ++last;
+        }
+
+        Batch batch{ first, last - first, 0, nullptr };
+        Shader* instancedShader = m_batcher ? m_batcher->getInstancedShader(head.shader) : nullptr;
+        if (instancedShader && batch.count >= InstanceBatcher::MIN_BATCH_SIZE) {
+            glm::mat4* matrices = m_batcher->allocate(batch.count, batch.firstInstance);
+            if (matrices) {
+                for (uint32_t i = 0; i < batch.count; ++i) {
+                    matrices[i] = m_packets[m_sortEntries[first + i].index].model;
+                }
+                batch.instancedShader = instancedShader;
+            }
+        }
+        m_batches.push_back(batch);
+        first = last;
+    }
+
+    if (m_batcher) m_batcher->end();
+}
+
+void RenderQueue::execute() {
+    m_stats = Stats{};
+    m_stats.packets = m_packets.size();
+    m_stats.customObjects = m_customObjects.size();
+
+    std::sort(m_sortEntries.begin(), m_sortEntries.end(),
+        [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+
+    buildBatches();
+
+    Shader* currentShader = nullptr;
+    GLuint currentTextures[DrawPacket::MAX_TEXTURES] = { 0, 0 };
+    const VAO* currentVAO = nullptr;
+    bool usedInstancing = false;
+
+    for (const Batch& batch : m_batches) {
+        const DrawPacket& head = m_packets[m_sortEntries[batch.first].index];
+        Shader* shader = batch.instancedShader ? batch.instancedShader : head.shader;
+
+        if (shader != currentShader) {
+            if (currentShader) currentShader->end();
+            shader->begin();
+            currentShader = shader;
+            ++m_stats.shaderChanges;
+        }
+
+        for (int unit = 0; unit < DrawPacket::MAX_TEXTURES; ++unit) {
+            const GLuint texture = head.textures[unit];
+            if (texture != 0 && texture != currentTextures[unit]) {
+                glActiveTexture(GL_TEXTURE0 + unit);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                currentTextures[unit] = texture;
+                ++m_stats.textureChanges;
+            }
+        }
+
+        if (head.vao != currentVAO) {
+            head.vao->bind();
+            currentVAO = head.vao;
+            ++m_stats.vaoChanges;
+        }
+
+        if (batch.instancedShader) {
+            head.vao->drawInstancedBound(batch.count, head.count, head.mode,
+                m_batcher->drawOffset() + batch.firstInstance);
+            ++m_stats.drawCalls;
+            ++m_stats.instancedBatches;
+            usedInstancing = true;
+            continue;
+        }
+
+        for (uint32_t i = 0; i < batch.count; ++i) {
+            const DrawPacket& packet = m_packets[m_sortEntries[batch.first + i].index];
+            packet.shader->setMat4(packet.modelLoc, packet.model);
+            packet.vao->drawBound(packet.mode, packet.count);
+            ++m_stats.drawCalls;
+        }
+    }
+
+    if (currentVAO) currentVAO->unbind();
+    if (currentShader) currentShader->end();
+    if (usedInstancing) m_batcher->fence();
+
+    // 自定义渲染对象自行管理状态
+    for (const Object* object : m_customObjects) {
+        object->render();
+    }
+}
@@ -0,0 +1,121 @@
+﻿#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include "../glFrameWork/core.h"
+#include "../glFrameWork/shader.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+class VAO;
+class Object;
+class InstanceBatcher;
+
+/**
+ * @brief 绘制包：一次绘制所需的全部状态（Shader、纹理、VAO、逐对象 Uniform）
+ */
+struct DrawPacket {
+    static constexpr int MAX_TEXTURES = 2;  // 支持的纹理单元数量
+
+    Shader* shader{ nullptr };                 // 着色器
+    GLuint textures[MAX_TEXTURES]{ 0, 0 };     // 各纹理单元绑定的纹理（0 表示该单元不使用）
+    const VAO* vao{ nullptr };                 // 几何
+    GLenum mode{ GL_TRIANGLES };               // 图元类型
+    GLsizei count{ 0 };                        // 顶点数（无 EBO 时，0 表示自动计算）
+    UniformHandle modelLoc;                    // uModel 位置
+    glm::mat4 model{ 1.0f };                   // 模型矩阵
+    bool instanceable{ false };                // VAO 来自共享几何缓存，可与相同网格/材质的包合并实例化绘制
+};
+
+/**
+ * @brief 按渲染状态排序的渲染队列
+ *
+ * 对象在 submit() 中提交绘制包，队列按 Shader → 纹理 → VAO 生成排序键并排序，
+ * 执行时只在状态真正变化时才切换，使用相同材质的对象共享一次绑定。
+ * 排序后键相同且可实例化的连续绘制包由 InstanceBatcher 合并为一次实例化绘制。
+ * 无法描述为绘制包的对象（如史莱姆）以自定义方式提交，在排序后的绘制包之后调用其 render()。
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief 渲染统计（最近一次 execute）
+     */
+    struct Stats {
+        size_t packets{ 0 };        // 绘制包数量
+        size_t customObjects{ 0 };  // 自定义渲染对象数量
+        size_t shaderChanges{ 0 };  // Shader 切换次数
+        size_t textureChanges{ 0 }; // 纹理绑定次数
+        size_t vaoChanges{ 0 };     // VAO 绑定次数
+        size_t drawCalls{ 0 };      // 绘制调用次数（不含自定义对象）
+        size_t instancedBatches{ 0 }; // 实例化批次数
+    };
+
+    /**
+     * @brief 设置实例化批处理器（为空时不做实例化合并）
+     */
+    void setInstanceBatcher(InstanceBatcher* batcher) { m_batcher = batcher; }
+
+    /**
+     * @brief 清空队列（每帧开始时调用）
+     */
+    void clear();
+
+    /**
+     * @brief 提交绘制包
+     * @param packet 绘制包
+     */
+    void submit(const DrawPacket& packet);
+
+    /**
+     * @brief 提交自定义渲染对象（执行时直接调用其 render()）
+     * @param object 对象指针
+     */
+    void submitCustom(const Object* object);
+
+    /**
+     * @brief 排序并执行所有绘制
+     */
+    void execute();
+
+    /**
+     * @brief 获取最近一次执行的统计
+     */
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    /**
+     * @brief 生成排序键：Shader(16位) | 纹理0(16位) | 纹理1(16位) | VAO(16位)
+     */
+    static uint64_t makeSortKey(const DrawPacket& packet);
+
+    /**
+     * @brief 两个绘制包能否合并为同一实例化批次（网格与材质完全相同）
+     */
+    static bool canBatch(const DrawPacket& a, const DrawPacket& b);
+
+    /**
+     * @brief 将排序后的绘制包划分为批次，并把实例化批次的模型矩阵写入流式缓冲
+     */
+    void buildBatches();
+
+    struct SortEntry {
+        uint64_t key;      // 排序键
+        uint32_t index;    // 在 m_packets 中的下标
+    };
+
+    std::vector<DrawPacket> m_packets;          // 绘制包
+    std::vector<SortEntry> m_sortEntries;       // 排序用的键（只排序键，不搬动绘制包）
+    std::vector<const Object*> m_customObjects; // 自定义渲染对象
+    Stats m_stats;
+
+    struct Batch {
+        uint32_t first;          // 在 m_sortEntries 中的起始位置
+        uint32_t count;          // 绘制包数量
+        GLuint firstInstance;    // 实例化批次在本帧实例区域中的起始实例
+        Shader* instancedShader; // 实例化 Shader（为空表示逐包绘制）
+    };
+    std::vector<Batch> m_batches;               // 本帧批次
+    InstanceBatcher* m_batcher{ nullptr };      // 实例化批处理器
+};
+
+#endif // RENDER_QUEUE_H
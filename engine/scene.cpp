@@ -3,87 +3,625 @@
 #include "object/cube.h"
 #include "object/sphere.h"
 #include "object/plane.h"
+#include "instanceBatcher.h"
+#include "profiler.h"
 #include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <execution>
 
 Scene::Scene(Engine* engine) 
     : m_engine(engine) {
+    if (m_engine) {
+        m_renderQueue.setInstanceBatcher(m_engine->instanceBatcher);
+        if (m_engine->pWorld) {
+            m_engine->pWorld->setEventListener(&m_physicsListener);
+        }
+    }
 }
 
 Scene::~Scene() {
     // 清空对象列表，这会触发所有 unique_ptr 的析构
     // 从而调用每个 Object 的析构函数
+    stopPhysicsThread();
     clear();
+    if (m_engine && m_engine->pWorld) {
+        m_engine->pWorld->setEventListener(nullptr);
+    }
 }
 
-void Scene::addObject(Object* object) {
-    if (object) {
-        m_objects.emplace_back(object);
+ObjectHandle Scene::addObject(Object* object) {
+    if (!object) return ObjectHandle{};
+    waitForPhysics();  // 工作线程的接触回调会读取槽位与动态刚体列表
+    
+    // 分配槽位（优先复用空闲槽位）
+    uint32_t slotIndex;
+    if (m_freeSlot != ObjectHandle::INVALID_INDEX) {
+        slotIndex = m_freeSlot;
+        m_freeSlot = m_slots[slotIndex].nextFree;
+    } else {
+        slotIndex = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    Slot& slot = m_slots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(m_objects.size());
+    slot.nextFree = ObjectHandle::INVALID_INDEX;
+    
+    const ObjectHandle handle{ slotIndex, slot.generation };
+    object->setHandle(handle);
+    
+    // 类型注册表
+    TypeBucket& bucket = m_typeRegistry[std::type_index(typeid(*object))];
+    m_denseInfo.push_back({ slotIndex, &bucket, static_cast<uint32_t>(bucket.objects.size()) });
+    bucket.objects.push_back(object);
+    bucket.sequences.push_back(m_nextSequence++);
+    
+    // 名称索引（重名时保留先加入的对象）
+    m_nameIndex.emplace(object->getName(), handle);
+    
+    object->setBoundsProxy(m_boundsTree.createProxy(object->getWorldBounds(), object));
+    m_objects.emplace_back(object);
+    
+    // 变换数组（模型矩阵在下一次 update 中计算，先给出当前值）
+    object->consumeTransformDirty();
+    m_transforms.push_back({ object->getPosition(), object->getRotation(), object->getScale() });
+    m_modelMatrices.push_back(object->getModelMatrix());
+    m_transformChanged.push_back(1);
+    if (object->isDynamicBody()) {
+        m_dynamicBodiesDirty = true;
     }
+    return handle;
+}
+
+Object* Scene::getObject(ObjectHandle handle) const {
+    if (!handle.isValid() || handle.index >= m_slots.size()) return nullptr;
+    const Slot& slot = m_slots[handle.index];
+    if (slot.generation != handle.generation) return nullptr;
+    return m_objects[slot.denseIndex].get();
 }
 
 void Scene::removeObject(Object* object) {
-    if (!object) return;
+    if (!object || getObject(object->getHandle()) != object) return;
+    removeAt(m_slots[object->getHandle().index].denseIndex);
+}
+
+void Scene::removeObject(ObjectHandle handle) {
+    if (!getObject(handle)) return;
+    removeAt(m_slots[handle.index].denseIndex);
+}
+
+void Scene::removeAt(uint32_t denseIndex) {
+    waitForPhysics();  // 对象析构会销毁刚体
+    Object* object = m_objects[denseIndex].get();
+    m_frameForces.erase(std::remove_if(m_frameForces.begin(), m_frameForces.end(),
+        [object](const FrameForce& entry) { return entry.object == object; }), m_frameForces.end());
+    const DenseInfo info = m_denseInfo[denseIndex];
     
-    auto it = std::find_if(m_objects.begin(), m_objects.end(),
-        [object](const std::unique_ptr<Object>& obj) {
-            return obj.get() == object;
-        });
+    // 名称索引：只在索引仍指向该对象时删除
+    auto nameIt = m_nameIndex.find(object->getName());
+    if (nameIt != m_nameIndex.end() && nameIt->second == object->getHandle()) {
+        m_nameIndex.erase(nameIt);
+    }
+    
+    // 类型桶：保持加入顺序，后面的对象前移（移除不在热路径上）
+    std::vector<Object*>& bucketObjects = info.bucket->objects;
+    bucketObjects.erase(bucketObjects.begin() + info.bucketPos);
+    info.bucket->sequences.erase(info.bucket->sequences.begin() + info.bucketPos);
+    for (uint32_t i = info.bucketPos; i < bucketObjects.size(); ++i) {
+        m_denseInfo[m_slots[bucketObjects[i]->getHandle().index].denseIndex].bucketPos = i;
+    }
+    
+    m_boundsTree.destroyProxy(object->getBoundsProxy());
+    object->setBoundsProxy(-1);
+    object->setHandle(ObjectHandle{});
+    
+    // 释放槽位：代数递增，旧句柄失效
+    Slot& slot = m_slots[info.slot];
+    ++slot.generation;
+    slot.nextFree = m_freeSlot;
+    m_freeSlot = info.slot;
     
-    if (it != m_objects.end()) {
-        m_objects.erase(it);
+    // 稠密数组：末尾对象换入
+    const uint32_t last = static_cast<uint32_t>(m_objects.size()) - 1;
+    if (denseIndex != last) {
+        m_objects[denseIndex] = std::move(m_objects[last]);
+        m_denseInfo[denseIndex] = m_denseInfo[last];
+        m_transforms[denseIndex] = m_transforms[last];
+        m_modelMatrices[denseIndex] = m_modelMatrices[last];
+        m_transformChanged[denseIndex] = m_transformChanged[last];
+        m_slots[m_denseInfo[denseIndex].slot].denseIndex = denseIndex;
+    }
+    std::unique_ptr<Object> removed = std::move(m_objects.back());
+    m_objects.pop_back();
+    m_denseInfo.pop_back();
+    m_transforms.pop_back();
+    m_modelMatrices.pop_back();
+    m_transformChanged.pop_back();
+    m_dynamicBodiesDirty = true;
+    
+    // 索引已更新完毕后再销毁对象
+    removed.reset();
+}
+
+void Scene::onObjectRenamed(Object* object, const std::string& oldName) {
+    auto it = m_nameIndex.find(oldName);
+    if (it != m_nameIndex.end() && it->second == object->getHandle()) {
+        m_nameIndex.erase(it);
     }
+    m_nameIndex.emplace(object->getName(), object->getHandle());
+}
+
+void Scene::onObjectPhysicsChanged(Object* /*object*/) {
+    m_dynamicBodiesDirty = true;
+}
+
+void Scene::wakeObject(Object* object) {
+    // 列表待重建时所有动态刚体都会重新视为醒着
+    if (m_dynamicBodiesDirty || getObject(object->getHandle()) != object) return;
+    const uint32_t denseIndex = m_slots[object->getHandle().index].denseIndex;
+    if (denseIndex >= m_denseToDynamic.size()) return;
+    const uint32_t dynamicIndex = m_denseToDynamic[denseIndex];
+    if (dynamicIndex == ObjectHandle::INVALID_INDEX || m_dynamicBodies[dynamicIndex].awake) return;
+    m_dynamicBodies[dynamicIndex].awake = true;
+    m_awakeBodies.push_back(dynamicIndex);
+}
+
+void Scene::PhysicsEventListener::onContact(const rp3d::CollisionCallback::CallbackData& callbackData) {
+    // 醒着的刚体碰到睡眠刚体时物理引擎会唤醒后者，这里同步放回醒着集合
+    for (rp3d::uint32 i = 0; i < callbackData.getNbContactPairs(); ++i) {
+        const rp3d::CollisionCallback::ContactPair pair = callbackData.getContactPair(i);
+        if (pair.getEventType() == rp3d::CollisionCallback::ContactPair::EventType::ContactExit) continue;
+        if (Object* obj = static_cast<Object*>(pair.getBody1()->getUserData())) m_scene->wakeObject(obj);
+        if (Object* obj = static_cast<Object*>(pair.getBody2()->getUserData())) m_scene->wakeObject(obj);
+    }
+}
+
+const glm::mat4* Scene::getModelMatrix(ObjectHandle handle) const {
+    if (!getObject(handle)) return nullptr;
+    return &m_modelMatrices[m_slots[handle.index].denseIndex];
+}
+
+const Scene::Transform* Scene::getTransform(ObjectHandle handle) const {
+    if (!getObject(handle)) return nullptr;
+    return &m_transforms[m_slots[handle.index].denseIndex];
 }
 
 void Scene::update(float deltaTime) {
-    // ✅ 修复：限制物理时间步长，防止窗口暂停时的巨大 deltaTime
-    const float maxPhysicsDeltaTime = 0.033f;  // 最大物理步长：约 30 FPS
-    const float minPhysicsDeltaTime = 0.001f;  // 最小物理步长：防止除零
+    PROFILE_SCOPE("Scene::update");
+    // ✅ 修复：限制帧时间，防止窗口暂停时的巨大 deltaTime
+    const float maxFrameDeltaTime = 0.033f;  // 对象更新的最大帧时间：约 30 FPS
+    const float minFrameDeltaTime = 0.001f;  // 最小帧时间：防止除零
+    const float frameDeltaTime = std::clamp(deltaTime, minFrameDeltaTime, maxFrameDeltaTime);
+    // 物理累加器使用真实帧时间，只截掉长时间卡顿（拖动窗口、断点），积压由 m_maxSubSteps 限制
+    const float maxPhysicsDeltaTime = 0.25f;
+    const float physicsDeltaTime = std::clamp(deltaTime, 0.0f, maxPhysicsDeltaTime);
+    const bool hasPhysics = m_engine && m_engine->pWorld;
     
-    // 如果 deltaTime 异常大 限制到最大值
-    float physicsDeltaTime = deltaTime;
-    if (physicsDeltaTime > maxPhysicsDeltaTime) {
-        physicsDeltaTime = maxPhysicsDeltaTime;
+    if (hasPhysics && m_physicsPipelined) {
+        // 同步点：上一帧交给工作线程的物理步完成后，执行排队的命令并取回结果
+        waitForPhysics();
+        applyPhysicsCommands();
+        rebuildDynamicBodies();
+        interpolatePhysicsTransforms(m_pipelinedAlpha);
+    } else if (hasPhysics) {
+        // 固定步长推进物理世界，剩余时间留到下一帧
+        rebuildDynamicBodies();
+        const int steps = advanceAccumulator(physicsDeltaTime);
+        takeFrameForces(steps);
+        runPhysicsSteps(steps);
+        
+        // 在上一步与当前步之间插值出渲染变换
+        interpolatePhysicsTransforms(m_physicsAccumulator / m_fixedTimeStep);
     }
-    if (physicsDeltaTime < minPhysicsDeltaTime) {
-        physicsDeltaTime = minPhysicsDeltaTime;
+    // 此后（对象更新中）施加的力按本帧时长计入冲量
+    m_forceDeltaTime = physicsDeltaTime;
+    
+    // 更新所有活跃对象
+    {
+        PROFILE_SCOPE("Scene::updateObjects");
+        for (auto& obj : m_objects) {
+            if (obj && obj->isActive()) {
+                obj->update(frameDeltaTime);
+            }
+        }
     }
     
-    // 更新物理世界
-    if (m_engine && m_engine->pWorld) {
-        m_engine->pWorld->update(physicsDeltaTime);
+    {
+        PROFILE_SCOPE("Scene::updateTransforms");
+        // 收集变换
+        updateTransforms();
+        
+        // 同步变化对象的包围盒，再计算其模型矩阵（清除变化标记）
+        updateBounds();
+        updateModelMatrices();
     }
     
-    // 更新所有活跃对象
-    for (auto& obj : m_objects) {
-        if (obj && obj->isActive()) {
-            obj->update(physicsDeltaTime);
+    // 流水线模式：下一帧的物理步在工作线程上与本帧渲染重叠执行
+    if (hasPhysics && m_physicsPipelined) {
+        rebuildDynamicBodies();
+        const int steps = advanceAccumulator(physicsDeltaTime);
+        m_pipelinedAlpha = m_physicsAccumulator / m_fixedTimeStep;
+        takeFrameForces(steps);
+        kickPhysics(steps);
+    }
+}
+
+int Scene::advanceAccumulator(float frameDeltaTime) {
+    m_physicsAccumulator += frameDeltaTime;
+    int steps = 0;
+    while (m_physicsAccumulator >= m_fixedTimeStep && steps < m_maxSubSteps) {
+        m_physicsAccumulator -= m_fixedTimeStep;
+        ++steps;
+    }
+    // 达到单帧步数上限时丢弃积压时间，避免越落越远
+    if (m_physicsAccumulator >= m_fixedTimeStep) {
+        const float simulated = static_cast<float>(steps) * m_fixedTimeStep;
+        const float total = simulated + m_physicsAccumulator;
+        m_physicsAccumulator = std::fmod(m_physicsAccumulator, m_fixedTimeStep);
+        // 丢弃的时间不再模拟，对应的冲量按比例一并丢弃，否则平均力会被放大
+        const float kept = (simulated + m_physicsAccumulator) / total;
+        for (FrameForce& entry : m_frameForces) entry.impulse *= kept;
+    }
+    return steps;
+}
+
+void Scene::takeFrameForces(int steps) {
+    if (steps <= 0) return;
+    // 冲量均摊到这批固定步上：高帧率时多帧的力合并到一步，低帧率时一帧的力分到多步
+    const float invDuration = 1.0f / (static_cast<float>(steps) * m_fixedTimeStep);
+    m_stepForces.clear();
+    for (const FrameForce& entry : m_frameForces) {
+        m_stepForces.push_back({ entry.object, entry.impulse * invDuration });
+    }
+    m_frameForces.clear();
+}
+
+void Scene::runPhysicsSteps(int steps) {
+    PROFILE_SCOPE("Scene::runPhysicsSteps");
+    for (int i = 0; i < steps; ++i) {
+        beginPhysicsStep();
+        for (const StepForce& entry : m_stepForces) {
+            if (rp3d::RigidBody* body = entry.object->getRigidBody()) {
+                body->applyWorldForceAtCenterOfMass(rp3d::Vector3(entry.force.x, entry.force.y, entry.force.z));
+            }
+        }
+        {
+            PROFILE_SCOPE("PhysicsWorld::update");
+            m_engine->pWorld->update(m_fixedTimeStep);
         }
+        capturePhysicsStep();
     }
+    m_stepForces.clear();
 }
 
-void Scene::render() const {
-    // 渲染所有活跃对象
-    for (const auto& obj : m_objects) {
-        if (obj && obj->isActive()) {
-            obj->render();
+void Scene::setPhysicsPipelined(bool enabled) {
+    if (enabled == m_physicsPipelined) return;
+    waitForPhysics();
+    m_physicsPipelined = enabled;
+    if (!enabled) {
+        // 切回同步模式前执行完剩余命令
+        applyPhysicsCommands();
+        stopPhysicsThread();
+    }
+}
+
+bool Scene::queuePhysicsCommand(const PhysicsCommand& command) {
+    if (!m_physicsPipelined) return false;
+    if (!m_commandQueue.push(command)) {
+        m_droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void Scene::addFrameForce(Object* object, const glm::vec3& force) {
+    m_frameForces.push_back({ object, force * m_forceDeltaTime });
+    wakeObject(object);
+}
+
+void Scene::applyPhysicsCommands() {
+    PhysicsCommand command;
+    while (m_commandQueue.pop(command)) {
+        Object* obj = getObject(command.target);
+        rp3d::RigidBody* body = obj ? obj->getRigidBody() : nullptr;
+        if (!body) continue;
+        
+        switch (command.type) {
+            case PhysicsCommand::Type::APPLY_FORCE:
+                addFrameForce(obj, command.vector);
+                break;
+            case PhysicsCommand::Type::SET_TRANSFORM:
+                body->setTransform(rp3d::Transform(
+                    rp3d::Vector3(command.vector.x, command.vector.y, command.vector.z),
+                    rp3d::Quaternion(command.rotation.x, command.rotation.y, command.rotation.z, command.rotation.w)));
+                break;
+            case PhysicsCommand::Type::SET_VELOCITY:
+                body->setLinearVelocity(rp3d::Vector3(command.vector.x, command.vector.y, command.vector.z));
+                wakeObject(obj);
+                break;
         }
     }
+    
+    const uint32_t dropped = m_droppedCommands.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        std::cout << "[Scene] 物理命令队列已满，丢弃 " << dropped << " 条命令" << std::endl;
+    }
+}
+
+void Scene::kickPhysics(int steps) {
+    if (steps <= 0) return;
+    if (!m_physicsThread.joinable()) {
+        m_physicsThreadExit = false;
+        m_physicsThread = std::thread(&Scene::physicsThreadLoop, this);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_physicsMutex);
+        m_pendingSteps = steps;
+        m_physicsBusy = true;
+    }
+    m_physicsCv.notify_all();
+}
+
+void Scene::waitForPhysics() {
+    if (!m_physicsThread.joinable()) return;
+    std::unique_lock<std::mutex> lock(m_physicsMutex);
+    m_physicsCv.wait(lock, [this] { return !m_physicsBusy; });
+}
+
+void Scene::onStateRestored() {
+    waitForPhysics();
+    PhysicsCommand command;
+    while (m_commandQueue.pop(command)) {}
+    m_frameForces.clear();
+    m_stepForces.clear();
+    
+    for (uint32_t i = 0; i < m_objects.size(); ++i) {
+        Object* obj = m_objects[i].get();
+        obj->consumeTransformDirty();
+        m_transforms[i] = Transform{ obj->getPosition(), obj->getRotation(), obj->getScale() };
+        m_transformChanged[i] = 1;
+    }
+    updateBounds();
+    updateModelMatrices();
+    
+    m_dynamicBodiesDirty = true;
+    m_physicsAccumulator = 0.0f;
+    m_pipelinedAlpha = 0.0f;
+}
+
+void Scene::stopPhysicsThread() {
+    if (!m_physicsThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_physicsMutex);
+        m_physicsThreadExit = true;
+    }
+    m_physicsCv.notify_all();
+    m_physicsThread.join();
+}
+
+void Scene::physicsThreadLoop() {
+    Profiler::instance().setThreadName("Physics");
+    std::unique_lock<std::mutex> lock(m_physicsMutex);
+    for (;;) {
+        m_physicsCv.wait(lock, [this] { return m_pendingSteps > 0 || m_physicsThreadExit; });
+        if (m_physicsThreadExit) return;
+        
+        const int steps = m_pendingSteps;
+        m_pendingSteps = 0;
+        lock.unlock();
+        runPhysicsSteps(steps);
+        lock.lock();
+        
+        m_physicsBusy = false;
+        m_physicsCv.notify_all();
+    }
+}
+
+void Scene::setFixedTimeStep(float step) {
+    m_fixedTimeStep = std::max(step, 0.001f);
+}
+
+void Scene::setMaxSubSteps(int steps) {
+    m_maxSubSteps = std::max(steps, 1);
+}
+
+void Scene::rebuildDynamicBodies() {
+    if (!m_dynamicBodiesDirty) return;
+    
+    // 全部视为醒着，下一次物理步后再把已入睡的移出
+    m_dynamicBodies.clear();
+    m_awakeBodies.clear();
+    m_settledBodies.clear();
+    m_denseToDynamic.assign(m_objects.size(), ObjectHandle::INVALID_INDEX);
+    for (uint32_t i = 0; i < m_objects.size(); ++i) {
+        Object* obj = m_objects[i].get();
+        if (obj->isDynamicBody()) {
+            const Transform& t = m_transforms[i];
+            m_denseToDynamic[i] = static_cast<uint32_t>(m_dynamicBodies.size());
+            m_awakeBodies.push_back(static_cast<uint32_t>(m_dynamicBodies.size()));
+            m_dynamicBodies.push_back({ i, obj->getRigidBody(), obj, true,
+                                        t.position, t.rotation, t.position, t.rotation });
+        }
+    }
+    m_dynamicBodiesDirty = false;
+}
+
+void Scene::beginPhysicsStep() {
+    for (uint32_t dynamicIndex : m_awakeBodies) {
+        DynamicBody& entry = m_dynamicBodies[dynamicIndex];
+        entry.previousPosition = entry.currentPosition;
+        entry.previousRotation = entry.currentRotation;
+    }
+}
+
+void Scene::capturePhysicsStep() {
+    // 每个刚体只写自己的同步项，可安全并行
+    std::for_each(std::execution::par, m_awakeBodies.begin(), m_awakeBodies.end(),
+        [this](uint32_t dynamicIndex) {
+            DynamicBody& entry = m_dynamicBodies[dynamicIndex];
+            const rp3d::Transform& transform = entry.body->getTransform();
+            const rp3d::Vector3& p = transform.getPosition();
+            const rp3d::Quaternion& q = transform.getOrientation();
+            entry.currentPosition = glm::vec3(p.x, p.y, p.z);
+            entry.currentRotation = glm::quat(q.w, q.x, q.y, q.z);
+            entry.awake = !entry.body->isSleeping();
+        });
+    
+    // 移出本步入睡的刚体，插值时直接落到最终变换（可能在工作线程上，不写渲染变换）
+    for (size_t i = 0; i < m_awakeBodies.size();) {
+        if (m_dynamicBodies[m_awakeBodies[i]].awake) {
+            ++i;
+            continue;
+        }
+        m_settledBodies.push_back(m_awakeBodies[i]);
+        m_awakeBodies[i] = m_awakeBodies.back();
+        m_awakeBodies.pop_back();
+    }
+}
+
+void Scene::interpolatePhysicsTransforms(float alpha) {
+    for (uint32_t dynamicIndex : m_settledBodies) {
+        const DynamicBody& entry = m_dynamicBodies[dynamicIndex];
+        writePhysicsTransform(entry, entry.currentPosition, entry.currentRotation);
+    }
+    m_settledBodies.clear();
+    
+    std::for_each(std::execution::par, m_awakeBodies.begin(), m_awakeBodies.end(),
+        [this, alpha](uint32_t dynamicIndex) {
+            DynamicBody& entry = m_dynamicBodies[dynamicIndex];
+            writePhysicsTransform(entry,
+                glm::mix(entry.previousPosition, entry.currentPosition, alpha),
+                glm::slerp(entry.previousRotation, entry.currentRotation, alpha));
+        });
+}
+
+void Scene::writePhysicsTransform(const DynamicBody& entry, const glm::vec3& position, const glm::quat& rotation) {
+    Transform& t = m_transforms[entry.denseIndex];
+    t.position = position;
+    t.rotation = rotation;
+    entry.object->setTransformFromPhysics(position, rotation);
+    m_transformChanged[entry.denseIndex] = 1;
+}
+
+void Scene::updateTransforms() {
+    // 收集非物理路径修改过的变换（setter、速度积分、子类直接写入）
+    std::for_each(std::execution::par, m_transforms.begin(), m_transforms.end(),
+        [this](Transform& t) {
+            const size_t i = &t - m_transforms.data();
+            Object* obj = m_objects[i].get();
+            if (obj->consumeTransformDirty()) {
+                t = Transform{ obj->getPosition(), obj->getRotation(), obj->getScale() };
+                m_transformChanged[i] = 1;
+            }
+        });
+}
+
+void Scene::updateModelMatrices() {
+    // 只重算变换有变化的对象：平移 * 旋转 * 缩放
+    std::for_each(std::execution::par_unseq, m_transforms.begin(), m_transforms.end(),
+        [this](const Transform& t) {
+            const size_t i = &t - m_transforms.data();
+            if (!m_transformChanged[i]) return;
+            m_transformChanged[i] = 0;
+            glm::mat4 model = glm::mat4_cast(t.rotation);
+            model[0] *= t.scale.x;
+            model[1] *= t.scale.y;
+            model[2] *= t.scale.z;
+            model[3] = glm::vec4(t.position, 1.0f);
+            m_modelMatrices[i] = model;
+        });
+}
+
+void Scene::updateBounds() {
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        Object* obj = m_objects[i].get();
+        if (m_transformChanged[i] && obj->isActive() && obj->getBoundsProxy() >= 0) {
+            m_boundsTree.moveProxy(obj->getBoundsProxy(), obj->getWorldBounds());
+        }
+    }
+}
+
+void Scene::render() {
+    PROFILE_SCOPE("Scene::render");
+    GPU_TIMER_SCOPE(m_engine ? m_engine->gpuTimer : nullptr, "Scene::render");
+    
+    // 从相机提取视锥
+    glm::mat4 viewProjection(1.0f);
+    if (m_engine && m_engine->camera) {
+        viewProjection = m_engine->camera->getProjectionMatrix() * m_engine->camera->getViewMatrix();
+        m_frustum.update(viewProjection);
+    }
+    
+    // 1. 视锥剔除：收集视锥内的活跃对象
+    m_frustumVisible.clear();
+    {
+        PROFILE_SCOPE("Scene::frustumCull");
+        m_boundsTree.query(m_frustum, [this](void* userData) {
+            const Object* obj = static_cast<const Object*>(userData);
+            if (obj->isActive()) {
+                m_frustumVisible.push_back(obj);
+            }
+        });
+    }
+    
+    // 2. 遮挡剔除：光栅化视锥内的遮挡体
+    bool useOcclusion = false;
+    if (m_occlusionCullingEnabled) {
+        PROFILE_SCOPE("Scene::occlusionRasterize");
+        m_occlusionCuller.beginFrame(viewProjection);
+        m_occluderTriangles.clear();
+        for (const Object* obj : m_frustumVisible) {
+            if (obj->isOccluder()) {
+                obj->appendOccluderTriangles(m_occluderTriangles);
+            }
+        }
+        if (!m_occluderTriangles.empty()) {
+            m_occlusionCuller.addOccluder(m_occluderTriangles);
+            m_occlusionCuller.rasterize();
+            useOcclusion = true;
+        }
+    }
+    
+    // 3. 提交通过测试的对象（遮挡体自身总是提交）
+    m_renderQueue.clear();
+    m_visibleCount = 0;
+    {
+        PROFILE_SCOPE("Scene::submit");
+        for (const Object* obj : m_frustumVisible) {
+            if (useOcclusion && !obj->isOccluder() && !m_occlusionCuller.isVisible(obj->getWorldBounds())) {
+                continue;
+            }
+            obj->submit(m_renderQueue, m_modelMatrices[m_slots[obj->getHandle().index].denseIndex]);
+            ++m_visibleCount;
+        }
+    }
+    
+    // 按 Shader → 纹理 → VAO 排序后执行
+    PROFILE_SCOPE("RenderQueue::execute");
+    m_renderQueue.execute();
 }
 
 void Scene::cleanupInactiveObjects() {
-    // 移除所有非活跃对象
-    m_objects.erase(
-        std::remove_if(m_objects.begin(), m_objects.end(),
-            [](const std::unique_ptr<Object>& obj) {
-                return !obj || !obj->isActive();
-            }),
-        m_objects.end()
-    );
+    // 从后往前移除所有非活跃对象，每次移除都是 O(1) 交换
+    for (size_t i = m_objects.size(); i-- > 0;) {
+        if (!m_objects[i]->isActive()) {
+            removeAt(static_cast<uint32_t>(i));
+        }
+    }
 }
 
 void Scene::clear() {
-    // 清空对象列表，unique_ptr 会自动删除对象
-    m_objects.clear();
+    // 逐个移除，使所有句柄失效
+    while (!m_objects.empty()) {
+        removeAt(static_cast<uint32_t>(m_objects.size()) - 1);
+    }
+    m_nameIndex.clear();
+    m_typeRegistry.clear();
+    m_dynamicBodies.clear();
+    m_awakeBodies.clear();
+    m_settledBodies.clear();
+    m_denseToDynamic.clear();
+    m_dynamicBodiesDirty = false;
+    m_boundsTree.clear();
 }
 
 size_t Scene::getActiveObjectCount() const {
@@ -97,10 +635,9 @@ size_t Scene::getActiveObjectCount() const {
 }
 
 Object* Scene::findObjectByName(const std::string& name) const {
-    for (const auto& obj : m_objects) {
-        if (obj && obj->getName() == name) {
-            return obj.get();
-        }
+    auto it = m_nameIndex.find(name);
+    if (it == m_nameIndex.end()) {
+        return nullptr;  // 未找到
     }
-    return nullptr;  // 未找到
+    return getObject(it->second);
 }
@@ -2,9 +2,24 @@
 #define SCENE_H
 
 #include <vector>
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <typeindex>
+#include <typeinfo>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include "object/object.h"
+#include "renderQueue.h"
+#include "aabbTree.h"
+#include "frustum.h"
+#include "occlusionCuller.h"
+#include "physicsCommandQueue.h"
 
 class Engine;
 class Cube;
@@ -13,9 +28,30 @@ class Plane;
 
 /**
  * @brief 场景管理类，负责管理所有游戏对象的生命周期
+ *
+ * 对象连续存放在稠密数组中（遍历友好），外部通过分代槽位句柄 ObjectHandle 引用对象：
+ * 槽位记录对象在稠密数组中的位置，移除时把末尾对象换到空位（O(1)），并递增槽位代数使旧句柄失效。
+ * 名称索引与按动态类型分桶的注册表在 addObject 时建立，查询不再线性扫描。
+ * 变换与模型矩阵按同一稠密下标连续存放：物理步进后批量并行同步所有动态刚体，
+ * 再一次性并行计算全部模型矩阵，渲染直接读取矩阵数组。
+ * 物理以固定步长推进（累加器，单帧步数有上限），渲染变换在上一步与当前步之间插值。
+ * 游戏逻辑本帧施加的力在本帧执行的每个固定步上重复施加，推力大小不随帧率变化。
+ * 流水线模式下物理步在工作线程上与本帧渲染重叠执行，下一帧 update 开头是同步点：
+ * 等待物理步完成后执行游戏逻辑经无锁队列提交的命令（施力/设置变换/设置速度）。
+ * 只有醒着的动态刚体参与同步：刚体入睡后移出醒着集合，接触事件或施力时再唤醒；
+ * 模型矩阵与包围盒也只为本帧变换有变化的对象重新计算。
  */
 class Scene {
 public:
+    /**
+     * @brief 对象变换（与稠密对象数组对齐存放）
+     */
+    struct Transform {
+        glm::vec3 position{ 0.0f };
+        glm::quat rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+        glm::vec3 scale{ 1.0f };
+    };
+
     /**
      * @brief 构造函数
      * @param engine 引擎指针
@@ -30,15 +66,112 @@ public:
     /**
      * @brief 添加对象到场景
      * @param object 对象指针（Scene将接管所有权）
+     * @return 对象句柄
      */
-    void addObject(Object* object);
+    ObjectHandle addObject(Object* object);
 
     /**
-     * @brief 移除对象（通过指针）
+     * @brief 移除对象（通过指针），O(1)
      * @param object 要移除的对象指针
      */
     void removeObject(Object* object);
 
+    /**
+     * @brief 移除对象（通过句柄），句柄失效时忽略
+     * @param handle 对象句柄
+     */
+    void removeObject(ObjectHandle handle);
+
+    /**
+     * @brief 通过句柄获取对象
+     * @return 对象指针，句柄失效（对象已移除）时返回nullptr
+     */
+    Object* getObject(ObjectHandle handle) const;
+
+    /**
+     * @brief 按稠密下标获取对象（0 ~ getObjectCount()-1，移除对象会改变其余对象的下标）
+     */
+    Object* getObjectAt(size_t denseIndex) const { return m_objects[denseIndex].get(); }
+
+    /**
+     * @brief 对象改名时由 Object::setName 调用，更新名称索引
+     */
+    void onObjectRenamed(Object* object, const std::string& oldName);
+
+    /**
+     * @brief 对象物理体变化时由 Object::initPhysics 调用，标记动态刚体列表需要重建
+     */
+    void onObjectPhysicsChanged(Object* object);
+
+    /**
+     * @brief 把对象的动态刚体放回醒着集合（接触事件与施力时调用，非动态对象忽略）
+     */
+    void wakeObject(Object* object);
+
+    /**
+     * @brief 设置物理固定步长（秒），默认 1/60
+     */
+    void setFixedTimeStep(float step);
+    float getFixedTimeStep() const { return m_fixedTimeStep; }
+
+    /**
+     * @brief 设置单帧最多物理步数，超出的积压时间被丢弃
+     */
+    void setMaxSubSteps(int steps);
+    int getMaxSubSteps() const { return m_maxSubSteps; }
+
+    /**
+     * @brief 启用/禁用流水线物理（物理步在工作线程上与渲染重叠，渲染落后物理一帧）
+     */
+    void setPhysicsPipelined(bool enabled);
+    bool isPhysicsPipelined() const { return m_physicsPipelined; }
+
+    /**
+     * @brief 等待工作线程上正在进行的物理步完成；在主线程访问物理世界前调用
+     */
+    void waitForPhysics();
+
+    /**
+     * @brief 对象状态被整体改写（快照恢复）后调用：丢弃排队的物理命令，重新收集全部变换，
+     * 刚体同步列表按新变换重建，插值不会从旧位置过渡，物理累计时间清零
+     */
+    void onStateRestored();
+
+    /**
+     * @brief 流水线模式下把命令放入队列，在下一个同步点执行（任意线程可调用）
+     * @return 非流水线模式返回 false，调用方应直接操作刚体
+     */
+    bool queuePhysicsCommand(const PhysicsCommand& command);
+
+    /**
+     * @brief 对动态刚体质心施加持续本帧的世界空间力（物理引擎每步后清除外力，这里按帧时长累积为冲量，
+     * 在下一批实际执行的固定步上以平均力施加；本帧不步进时留到下一帧，不会丢失也不会重复计入）
+     * 只在主线程、非物理步进期间调用；流水线模式下由同步点从命令队列转入
+     */
+    void addFrameForce(Object* object, const glm::vec3& force);
+
+    /**
+     * @brief 获取醒着的动态刚体数量
+     */
+    size_t getAwakeBodyCount() const { return m_awakeBodies.size(); }
+
+    /**
+     * @brief 获取动态刚体总数
+     */
+    size_t getDynamicBodyCount() const { return m_dynamicBodies.size(); }
+
+    /**
+     * @brief 通过句柄获取本帧模型矩阵
+     * @return 矩阵指针，句柄失效时返回nullptr
+     */
+    const glm::mat4* getModelMatrix(ObjectHandle handle) const;
+
+    /**
+     * @brief 通过句柄获取对象变换
+     * @return 变换指针，句柄失效时返回nullptr
+     */
+    const Transform* getTransform(ObjectHandle handle) const;
+
     /**
      * @brief 更新场景中所有活跃对象
      * @param deltaTime 时间增量
@@ -46,9 +179,36 @@ public:
     void update(float deltaTime);
 
     /**
-     * @brief 渲染场景中所有活跃对象
+     * @brief 渲染场景中所有可见的活跃对象
+     * 先用相机视锥剔除 AABB 树，再经渲染队列按状态排序后绘制
+     */
+    void render();
+
+    /**
+     * @brief 获取本帧视锥（render() 开始时从相机提取），供对象内部做更细粒度的剔除
+     */
+    const Frustum& getFrustum() const { return m_frustum; }
+
+    /**
+     * @brief 获取上一帧通过视锥与遮挡剔除的对象数量
+     */
+    size_t getVisibleObjectCount() const { return m_visibleCount; }
+
+    /**
+     * @brief 启用/禁用 CPU 遮挡剔除
      */
-    void render() const;
+    void setOcclusionCullingEnabled(bool enabled) { m_occlusionCullingEnabled = enabled; }
+    bool isOcclusionCullingEnabled() const { return m_occlusionCullingEnabled; }
+
+    /**
+     * @brief 获取遮挡剔除器（统计与调试深度缓冲）
+     */
+    const OcclusionCuller& getOcclusionCuller() const { return m_occlusionCuller; }
+
+    /**
+     * @brief 获取渲染队列（用于读取渲染统计）
+     */
+    const RenderQueue& getRenderQueue() const { return m_renderQueue; }
 
     /**
      * @brief 清理所有非活跃对象
@@ -71,31 +231,214 @@ public:
     size_t getActiveObjectCount() const;
 
     /**
-     * @brief 通过名称查找对象
+     * @brief 通过名称查找对象（哈希索引；名称应唯一，重名时索引只记录最先加入的对象）
      * @param name 对象名称
      * @return 找到的对象指针，如果未找到则返回nullptr
      */
     Object* findObjectByName(const std::string& name) const;
 
     /**
-     * @brief 按类型查找对象
+     * @brief 按类型查找对象（包括派生类型）
+     * 注册表按对象的动态类型分桶，每个桶只做一次 dynamic_cast 判断，不再逐对象转换
      * @tparam T 对象类型
-     * @return 该类型的所有对象指针列表
+     * @return 该类型的所有对象指针列表，按对象加入场景的顺序排列
      */
     template<typename T>
     std::vector<T*> findObjectsByType() const {
-        std::vector<T*> result;
-        for (auto& obj : m_objects) {
-            if (T* typed = dynamic_cast<T*>(obj.get())) {
-                result.push_back(typed);
+        std::vector<std::pair<uint64_t, T*>> ordered;
+        size_t matchedBuckets = 0;
+        for (const auto& [type, bucket] : m_typeRegistry) {
+            if (bucket.objects.empty() || !dynamic_cast<T*>(bucket.objects.front())) continue;
+            ++matchedBuckets;
+            ordered.reserve(ordered.size() + bucket.objects.size());
+            for (size_t i = 0; i < bucket.objects.size(); ++i) {
+                ordered.emplace_back(bucket.sequences[i], static_cast<T*>(bucket.objects[i]));
             }
         }
+        // 桶内已按加入顺序排列；匹配多个桶（按基类查询）时再按加入序号合并
+        if (matchedBuckets > 1) {
+            std::sort(ordered.begin(), ordered.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+        }
+        std::vector<T*> result;
+        result.reserve(ordered.size());
+        for (const auto& entry : ordered) result.push_back(entry.second);
         return result;
     }
 
 private:
+    // 同一动态类型的对象（按加入顺序，移除时保持顺序）
+    struct TypeBucket {
+        std::vector<Object*> objects;
+        std::vector<uint64_t> sequences;  // 与 objects 对应的加入序号
+    };
+
+    // 槽位：句柄 → 稠密数组位置
+    struct Slot {
+        uint32_t denseIndex{ 0 };                         // 对象在 m_objects 中的位置
+        uint32_t generation{ 0 };                         // 代数，移除时递增
+        uint32_t nextFree{ ObjectHandle::INVALID_INDEX }; // 空闲链表
+    };
+
+    // 稠密数组中每个对象的索引信息（与 m_objects 一一对应）
+    struct DenseInfo {
+        uint32_t slot;         // 所属槽位
+        TypeBucket* bucket;    // 类型桶（unordered_map 节点地址稳定）
+        uint32_t bucketPos;    // 在类型桶中的位置
+    };
+
+    // 动态刚体同步项（列表在对象增删或物理体变化后重建）
+    struct DynamicBody {
+        uint32_t denseIndex;     // 对象在稠密数组中的位置
+        rp3d::RigidBody* body;   // 刚体
+        Object* object;          // 对象
+        bool awake;              // 是否在醒着集合中
+        glm::vec3 previousPosition;  // 上一物理步的变换
+        glm::quat previousRotation;
+        glm::vec3 currentPosition;   // 当前物理步的变换
+        glm::quat currentRotation;
+    };
+
+    // 接收物理世界接触事件：接触中的动态刚体可能被唤醒
+    class PhysicsEventListener : public rp3d::EventListener {
+    public:
+        explicit PhysicsEventListener(Scene* scene) : m_scene(scene) {}
+        void onContact(const rp3d::CollisionCallback::CallbackData& callbackData) override;
+    private:
+        Scene* m_scene;
+    };
+
+    /**
+     * @brief 从所有索引中移除稠密位置 denseIndex 的对象并销毁它（稠密数组由末尾对象换入；类型桶保持加入顺序）
+     */
+    void removeAt(uint32_t denseIndex);
+
+    /**
+     * @brief 动态刚体列表待重建时重建（对象增删或物理体变化后）
+     */
+    void rebuildDynamicBodies();
+
+    /**
+     * @brief 累加帧时间，返回本帧应执行的固定步数（超过上限时丢弃积压时间）
+     */
+    int advanceAccumulator(float frameDeltaTime);
+
+    /**
+     * @brief 把累积的冲量换算为接下来 steps 个固定步上的平均力（steps 为 0 时保留到下一帧）
+     */
+    void takeFrameForces(int steps);
+
+    /**
+     * @brief 执行若干个固定物理步（流水线模式下在工作线程上调用）
+     */
+    void runPhysicsSteps(int steps);
+
+    /**
+     * @brief 同步点：执行队列中的物理命令
+     */
+    void applyPhysicsCommands();
+
+    /**
+     * @brief 把若干物理步交给工作线程（必要时先启动线程）
+     */
+    void kickPhysics(int steps);
+
+    /**
+     * @brief 停止并回收物理工作线程
+     */
+    void stopPhysicsThread();
+
+    /**
+     * @brief 物理工作线程主循环
+     */
+    void physicsThreadLoop();
+
+    /**
+     * @brief 物理步进前把醒着刚体的当前变换存为上一步变换
+     */
+    void beginPhysicsStep();
+
+    /**
+     * @brief 物理步进后批量并行读取醒着刚体的变换，并把本步入睡的刚体移到落定列表
+     */
+    void capturePhysicsStep();
+
+    /**
+     * @brief 落定刚体写入最终变换，醒着刚体按 alpha（累加器剩余时间 / 步长）插值渲染变换
+     */
+    void interpolatePhysicsTransforms(float alpha);
+
+    /**
+     * @brief 写入刚体的渲染变换并标记为变化
+     */
+    void writePhysicsTransform(const DynamicBody& entry, const glm::vec3& position, const glm::quat& rotation);
+
+    /**
+     * @brief 并行收集被修改过的对象变换并标记为变化
+     */
+    void updateTransforms();
+
+    /**
+     * @brief 并行重算变换有变化的对象的模型矩阵
+     */
+    void updateModelMatrices();
+
     Engine* m_engine;                                   // 引擎指针
-    std::vector<std::unique_ptr<Object>> m_objects;    // 所有对象列表
+    std::vector<std::unique_ptr<Object>> m_objects;    // 所有对象列表（稠密）
+    std::vector<DenseInfo> m_denseInfo;                 // 与 m_objects 对应的索引信息
+    std::vector<Transform> m_transforms;                // 与 m_objects 对应的变换
+    std::vector<glm::mat4> m_modelMatrices;             // 与 m_objects 对应的模型矩阵
+    std::vector<DynamicBody> m_dynamicBodies;           // 动态刚体同步列表
+    bool m_dynamicBodiesDirty{ false };                 // 动态刚体列表是否需要重建
+    std::vector<uint32_t> m_awakeBodies;                // 醒着的动态刚体（m_dynamicBodies 下标）
+    std::vector<uint32_t> m_settledBodies;              // 上次插值后入睡、尚未写入最终变换的刚体
+    std::vector<uint32_t> m_denseToDynamic;             // 稠密下标 → m_dynamicBodies 下标（重建时生成）
+    std::vector<uint8_t> m_transformChanged;            // 与 m_objects 对应：本帧变换是否变化
+    struct FrameForce {
+        Object* object;
+        glm::vec3 impulse;                              // 力 × 施加时的帧时长
+    };
+    struct StepForce {
+        Object* object;
+        glm::vec3 force;
+    };
+    std::vector<FrameForce> m_frameForces;              // 尚未被物理步消耗的冲量
+    std::vector<StepForce> m_stepForces;                // 本批固定步每步施加的平均力（流水线模式下归工作线程）
+    float m_forceDeltaTime{ 1.0f / 60.0f };             // addFrameForce 换算冲量用的帧时长
+    PhysicsEventListener m_physicsListener{ this };     // 物理接触事件监听
+    float m_fixedTimeStep{ 1.0f / 60.0f };              // 物理固定步长
+    int m_maxSubSteps{ 4 };                             // 单帧最多物理步数
+    float m_physicsAccumulator{ 0.0f };                 // 尚未模拟的时间
+
+    // 流水线物理
+    bool m_physicsPipelined{ false };                   // 是否启用流水线物理
+    float m_pipelinedAlpha{ 0.0f };                     // 工作线程上的物理步完成后使用的插值系数
+    PhysicsCommandQueue m_commandQueue;                 // 游戏逻辑 → 物理世界命令
+    std::atomic<uint32_t> m_droppedCommands{ 0 };       // 队列满时丢弃的命令数
+    std::thread m_physicsThread;                        // 物理工作线程
+    std::mutex m_physicsMutex;
+    std::condition_variable m_physicsCv;                // 通知工作线程有新任务 / 通知主线程任务完成
+    int m_pendingSteps{ 0 };                            // 交给工作线程的步数
+    bool m_physicsBusy{ false };                        // 工作线程是否在执行物理步
+    bool m_physicsThreadExit{ false };                  // 通知工作线程退出
+    std::vector<Slot> m_slots;                          // 句柄槽位
+    uint32_t m_freeSlot{ ObjectHandle::INVALID_INDEX }; // 空闲槽位链表头
+    std::unordered_map<std::string, ObjectHandle> m_nameIndex;       // 名称索引
+    std::unordered_map<std::type_index, TypeBucket> m_typeRegistry;  // 按动态类型分桶
+    uint64_t m_nextSequence{ 0 };                       // 下一个加入对象的序号
+    RenderQueue m_renderQueue;                          // 渲染队列（每帧复用，避免重新分配）
+    DynamicAABBTree m_boundsTree;                       // 场景包围体层次（对象世界包围盒）
+    Frustum m_frustum;                                  // 本帧相机视锥
+    size_t m_visibleCount{ 0 };                         // 上一帧可见对象数量
+    OcclusionCuller m_occlusionCuller;                  // CPU 遮挡剔除
+    bool m_occlusionCullingEnabled{ true };             // 是否启用遮挡剔除
+    std::vector<const Object*> m_frustumVisible;        // 视锥内的活跃对象（每帧复用）
+    std::vector<glm::vec3> m_occluderTriangles;         // 遮挡体三角形（每帧复用）
+
+    /**
+     * @brief 把本帧变换有变化的对象的世界包围盒同步到 AABB 树（仅在超出胖包围盒时调整树）
+     */
+    void updateBounds();
 };
 
 #endif // SCENE_H
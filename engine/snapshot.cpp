@@ -0,0 +1,302 @@
+﻿#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "snapshot.h"
+#include "engine.h"
+#include "scene.h"
+#include "profiler.h"
+#include "object/slime/slime.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+namespace {
+    const char MAGIC[4] = { 'G', 'S', 'S', 'N' };
+
+    static_assert(std::is_trivially_copyable_v<Snapshot::Header>, "snapshot records must be memcpy-able");
+    static_assert(std::is_trivially_copyable_v<Snapshot::ObjectRecord>, "snapshot records must be memcpy-able");
+    static_assert(std::is_trivially_copyable_v<Snapshot::SlimeRecord>, "snapshot records must be memcpy-able");
+    static_assert(std::is_trivially_copyable_v<Snapshot::ParticleRecord>, "snapshot records must be memcpy-able");
+    static_assert(sizeof(Snapshot::Header) == 64, "Snapshot::Header layout changed");
+
+    uint64_t alignUp(uint64_t offset) {
+        return (offset + 7) & ~uint64_t{ 7 };
+    }
+
+    // FNV-1a
+    uint32_t hashName(const std::string& name) {
+        uint32_t hash = 2166136261u;
+        for (unsigned char c : name) {
+            hash = (hash ^ c) * 16777619u;
+        }
+        return hash;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief 只读内存映射文件
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) return;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) return;
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping) return;
+            m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+            if (m_data) m_size = static_cast<size_t>(size.QuadPart);
+#else
+            m_fd = open(path.c_str(), O_RDONLY);
+            if (m_fd < 0) return;
+            struct stat st;
+            if (fstat(m_fd, &st) != 0 || st.st_size == 0) return;
+            void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+            if (data == MAP_FAILED) return;
+            m_data = data;
+            m_size = static_cast<size_t>(st.st_size);
+#endif
+        }
+
+        ~MappedFile() {
+#ifdef _WIN32
+            if (m_data) UnmapViewOfFile(m_data);
+            if (m_mapping) CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+            if (m_data) munmap(m_data, m_size);
+            if (m_fd >= 0) close(m_fd);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const void* data() const { return m_data; }
+        size_t size() const { return m_size; }
+
+    private:
+#ifdef _WIN32
+        HANDLE m_file{ INVALID_HANDLE_VALUE };
+        HANDLE m_mapping{ nullptr };
+#else
+        int m_fd{ -1 };
+#endif
+        void* m_data{ nullptr };
+        size_t m_size{ 0 };
+    };
+}
+
+Snapshot::~Snapshot() {
+    waitForWrite();
+}
+
+void Snapshot::waitForWrite() {
+    if (m_writer.joinable()) m_writer.join();
+}
+
+void Snapshot::capture(std::vector<uint8_t>& out) {
+    PROFILE_SCOPE("Snapshot::capture");
+    Scene* scene = m_engine->scene;
+    scene->waitForPhysics();  // 读取刚体速度前等工作线程上的物理步完成
+
+    const std::vector<Slime*> slimes = scene->findObjectsByType<Slime>();
+    uint64_t particleCount = 0;
+    for (Slime* slime : slimes) particleCount += slime->m_particles.size();
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, 4);
+    header.version = FORMAT_VERSION;
+    header.headerSize = sizeof(Header);
+    header.objectRecordSize = sizeof(ObjectRecord);
+    header.particleRecordSize = sizeof(ParticleRecord);
+    header.objectCount = static_cast<uint32_t>(scene->getObjectCount());
+    header.slimeCount = static_cast<uint32_t>(slimes.size());
+    header.particleCount = static_cast<uint32_t>(particleCount);
+    header.objectsOffset = alignUp(sizeof(Header));
+    header.slimesOffset = alignUp(header.objectsOffset + uint64_t{ header.objectCount } * sizeof(ObjectRecord));
+    header.particlesOffset = alignUp(header.slimesOffset + uint64_t{ header.slimeCount } * sizeof(SlimeRecord));
+    header.fileSize = header.particlesOffset + particleCount * sizeof(ParticleRecord);
+
+    // 一次定长分配，之后各段原地写入
+    out.assign(header.fileSize, 0);
+    std::memcpy(out.data(), &header, sizeof(Header));
+    ObjectRecord* objects = reinterpret_cast<ObjectRecord*>(out.data() + header.objectsOffset);
+    SlimeRecord* slimeRecords = reinterpret_cast<SlimeRecord*>(out.data() + header.slimesOffset);
+    ParticleRecord* particles = reinterpret_cast<ParticleRecord*>(out.data() + header.particlesOffset);
+
+    uint32_t slimeIndex = 0;
+    uint64_t particleIndex = 0;
+    for (uint32_t i = 0; i < header.objectCount; ++i) {
+        const Object* obj = scene->getObjectAt(i);
+        ObjectRecord& record = objects[i];
+        record.position = obj->getPosition();
+        record.rotation = obj->getRotation();
+        record.scale = obj->getScale();
+        record.velocity = obj->getVelocity();
+        record.linearVelocity = glm::vec3(0.0f);
+        record.angularVelocity = glm::vec3(0.0f);
+        record.nameHash = hashName(obj->getName());
+        record.flags = 0;
+        if (const rp3d::RigidBody* body = obj->getRigidBody()) {
+            const rp3d::Vector3& v = body->getLinearVelocity();
+            const rp3d::Vector3& w = body->getAngularVelocity();
+            record.linearVelocity = glm::vec3(v.x, v.y, v.z);
+            record.angularVelocity = glm::vec3(w.x, w.y, w.z);
+            record.flags |= FLAG_RIGID_BODY;
+        }
+
+        auto it = std::find(slimes.begin(), slimes.end(), obj);
+        if (it == slimes.end()) continue;
+        const std::vector<Slime::Particle>& source = (*it)->m_particles;
+        slimeRecords[slimeIndex++] = { i, static_cast<uint32_t>(source.size()), particleIndex };
+        for (const Slime::Particle& p : source) {
+            particles[particleIndex++] = { p.position, p.predictedPos, p.velocity, p.lambda };
+        }
+    }
+}
+
+bool Snapshot::save(const std::string& path) {
+    waitForWrite();
+    const auto start = std::chrono::steady_clock::now();
+    capture(m_buffer);
+    std::cout << "[Snapshot] 捕获 " << m_buffer.size() / 1024 << " KB 用时 " << elapsedMs(start) << " ms，后台写入 " << path << std::endl;
+
+    m_writer = std::thread([this, path]() {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()))) {
+            std::cout << "[Snapshot] 写入失败：" << path << std::endl;
+        }
+    });
+    return true;
+}
+
+bool Snapshot::load(const std::string& path) {
+    waitForWrite();  // 可能正要读取刚保存的同一个文件
+    MappedFile file(path);
+    if (!file.data()) {
+        std::cout << "[Snapshot] 无法映射 " << path << std::endl;
+        return false;
+    }
+    return restore(file.data(), file.size());
+}
+
+bool Snapshot::restore(const void* data, size_t size) {
+    PROFILE_SCOPE("Snapshot::restore");
+    const auto start = std::chrono::steady_clock::now();
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    Scene* scene = m_engine->scene;
+
+    // 校验头与各段范围
+    if (size < sizeof(Header)) {
+        std::cout << "[Snapshot] 文件过小，不是有效快照" << std::endl;
+        return false;
+    }
+    const Header& header = *reinterpret_cast<const Header*>(bytes);
+    if (std::memcmp(header.magic, MAGIC, 4) != 0 || header.version != FORMAT_VERSION ||
+        header.headerSize != sizeof(Header) || header.objectRecordSize != sizeof(ObjectRecord) ||
+        header.particleRecordSize != sizeof(ParticleRecord)) {
+        std::cout << "[Snapshot] 不是有效快照（或版本、记录布局不符）" << std::endl;
+        return false;
+    }
+    if (header.fileSize != size ||
+        header.objectsOffset % 8 || header.slimesOffset % 8 || header.particlesOffset % 8 ||
+        header.objectsOffset + uint64_t{ header.objectCount } * sizeof(ObjectRecord) > header.slimesOffset ||
+        header.slimesOffset + uint64_t{ header.slimeCount } * sizeof(SlimeRecord) > header.particlesOffset ||
+        header.particlesOffset + uint64_t{ header.particleCount } * sizeof(ParticleRecord) > size) {
+        std::cout << "[Snapshot] 快照已截断或段偏移无效" << std::endl;
+        return false;
+    }
+
+    const ObjectRecord* objects = reinterpret_cast<const ObjectRecord*>(bytes + header.objectsOffset);
+    const SlimeRecord* slimeRecords = reinterpret_cast<const SlimeRecord*>(bytes + header.slimesOffset);
+    const ParticleRecord* particles = reinterpret_cast<const ParticleRecord*>(bytes + header.particlesOffset);
+
+    // 先确认快照对应当前场景，再动手改写，避免只恢复一半
+    if (header.objectCount != scene->getObjectCount()) {
+        std::cout << "[Snapshot] 对象数不符：快照 " << header.objectCount << "，场景 " << scene->getObjectCount() << std::endl;
+        return false;
+    }
+    for (uint32_t i = 0; i < header.objectCount; ++i) {
+        if (objects[i].nameHash != hashName(scene->getObjectAt(i)->getName())) {
+            std::cout << "[Snapshot] 第 " << i << " 个对象与快照不对应：" << scene->getObjectAt(i)->getName() << std::endl;
+            return false;
+        }
+    }
+    for (uint32_t s = 0; s < header.slimeCount; ++s) {
+        const SlimeRecord& record = slimeRecords[s];
+        const Slime* slime = record.objectIndex < header.objectCount ? dynamic_cast<const Slime*>(scene->getObjectAt(record.objectIndex)) : nullptr;
+        if (!slime || slime->m_particles.size() != record.particleCount ||
+            record.firstParticle + record.particleCount > header.particleCount) {
+            std::cout << "[Snapshot] 史莱姆记录 " << s << " 与场景不符" << std::endl;
+            return false;
+        }
+    }
+
+    scene->waitForPhysics();  // 不能与工作线程上的物理步同时改写刚体
+
+    // 对象：变换与速度
+    for (uint32_t i = 0; i < header.objectCount; ++i) {
+        const ObjectRecord& record = objects[i];
+        Object* obj = scene->getObjectAt(i);
+        obj->setPosition(record.position);
+        obj->setRotation(record.rotation);
+        obj->setScale(record.scale);
+        obj->setVelocity(record.velocity);
+
+        // 刚体直接写入（排队的命令由 Scene::onStateRestored 丢弃）
+        rp3d::RigidBody* body = obj->getRigidBody();
+        if (body && (record.flags & FLAG_RIGID_BODY)) {
+            body->setTransform(rp3d::Transform(
+                rp3d::Vector3(record.position.x, record.position.y, record.position.z),
+                rp3d::Quaternion(record.rotation.x, record.rotation.y, record.rotation.z, record.rotation.w)));
+            if (body->getType() == rp3d::BodyType::STATIC) continue;
+            body->setLinearVelocity(rp3d::Vector3(record.linearVelocity.x, record.linearVelocity.y, record.linearVelocity.z));
+            body->setAngularVelocity(rp3d::Vector3(record.angularVelocity.x, record.angularVelocity.y, record.angularVelocity.z));
+            if (obj->isDynamicBody()) {
+                body->resetForce();
+                body->resetTorque();
+                body->setIsSleeping(false);
+            }
+        }
+    }
+
+    // 史莱姆：粒子状态，受力与位置修正每步重新计算，清零即可
+    for (uint32_t s = 0; s < header.slimeCount; ++s) {
+        const SlimeRecord& record = slimeRecords[s];
+        Slime* slime = static_cast<Slime*>(scene->getObjectAt(record.objectIndex));
+        const ParticleRecord* source = particles + record.firstParticle;
+        for (uint32_t i = 0; i < record.particleCount; ++i) {
+            Slime::Particle& p = slime->m_particles[i];
+            p.position = source[i].position;
+            p.predictedPos = source[i].predictedPos;
+            p.velocity = source[i].velocity;
+            p.lambda = source[i].lambda;
+            p.force = glm::vec3(0.0f);
+            p.deltaPos = glm::vec3(0.0f);
+        }
+        slime->updateBounds();
+        slime->m_meshUpdateTimer = slime->m_meshUpdateInterval;  // 下一帧即重建网格
+    }
+
+    scene->onStateRestored();
+    std::cout << "[Snapshot] 恢复 " << header.objectCount << " 个对象、" << header.particleCount
+              << " 个粒子用时 " << elapsedMs(start) << " ms" << std::endl;
+    return true;
+}
@@ -0,0 +1,107 @@
+﻿#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Engine;
+
+/**
+ * @brief 场景状态的二进制快照（检查点与恢复）
+ *
+ * 保存：一次遍历把所有对象的变换与速度、所有史莱姆的粒子状态拷进预先分配好的缓冲，
+ * 文件写入交给后台线程，主线程不等待磁盘。
+ * 恢复：把文件内存映射后直接按固定布局的结构体数组访问，不做解析，
+ * 对象与粒子各一遍写回，随后场景重新收集变换、重建刚体同步列表。
+ *
+ * 快照按场景稠密顺序对应对象，只能恢复到同一构建、同一 setupDemoData 生成的场景
+ * （对象数、名称哈希与粒子数须一致，否则拒绝恢复）。
+ *
+ * 布局（本机字节序，各段 8 字节对齐）：Header | ObjectRecord×objectCount | SlimeRecord×slimeCount | ParticleRecord×particleCount
+ */
+class Snapshot {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct Header {
+        char magic[4];                // "GSSN"
+        uint32_t version;
+        uint32_t headerSize;          // 以下三项校验结构体布局与写入方一致
+        uint32_t objectRecordSize;
+        uint32_t particleRecordSize;
+        uint32_t objectCount;
+        uint32_t slimeCount;
+        uint32_t particleCount;       // 所有史莱姆的粒子总数
+        uint64_t objectsOffset;
+        uint64_t slimesOffset;
+        uint64_t particlesOffset;
+        uint64_t fileSize;
+    };
+
+    struct ObjectRecord {
+        glm::vec3 position;
+        glm::quat rotation;
+        glm::vec3 scale;
+        glm::vec3 velocity;          // Object::getVelocity（非刚体对象按此积分）
+        glm::vec3 linearVelocity;    // 刚体线速度
+        glm::vec3 angularVelocity;   // 刚体角速度
+        uint32_t nameHash;           // 对象名称的 FNV-1a 哈希，恢复时校验对应关系
+        uint32_t flags;
+    };
+
+    struct SlimeRecord {
+        uint32_t objectIndex;        // 在 ObjectRecord 数组中的下标
+        uint32_t particleCount;
+        uint64_t firstParticle;      // 在 ParticleRecord 数组中的起始下标
+    };
+
+    struct ParticleRecord {
+        glm::vec3 position;
+        glm::vec3 predictedPos;
+        glm::vec3 velocity;
+        float lambda;
+    };
+
+    enum ObjectFlags : uint32_t {
+        FLAG_RIGID_BODY = 1   // 记录了刚体变换与速度
+    };
+
+    explicit Snapshot(Engine* engine) : m_engine(engine) {}
+    ~Snapshot();
+
+    /**
+     * @brief 捕获当前状态并在后台线程写入 path（上一次写入未完成时先等待）
+     */
+    bool save(const std::string& path);
+
+    /**
+     * @brief 内存映射 path 并恢复
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief 从内存中的快照恢复（data 须 8 字节对齐）
+     */
+    bool restore(const void* data, size_t size);
+
+    /**
+     * @brief 把当前状态捕获到 out（覆盖原内容，保留容量）
+     */
+    void capture(std::vector<uint8_t>& out);
+
+    /**
+     * @brief 等待后台写入完成
+     */
+    void waitForWrite();
+
+private:
+    Engine* m_engine;
+    std::vector<uint8_t> m_buffer;  // 捕获缓冲（写入线程结束前不复用）
+    std::thread m_writer;           // 后台写入线程
+};
+
+#endif // SNAPSHOT_H
@@ -158,6 +158,212 @@ using VBO = Buffer<T>;
 template<typename T = unsigned int>
 using EBO = Buffer<T>;
 
+/**
+ * @class StreamingBuffer
+ * @brief 持久映射的流式缓冲（环形三缓冲），用于每帧更新的顶点/实例数据。
+ *
+ * 使用 glBufferStorage + GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT 一次性映射整个缓冲，
+ * 缓冲被划分为 REGION_COUNT 个区域轮流写入。每个区域在提交绘制后插入 fence，
+ * 再次写入该区域前只等待对应 fence，避免 glBufferSubData/glBufferData 的隐式 CPU/GPU 同步。
+ *
+ * 用法：beginWrite() 取得当前写区域指针并直接写入 → endWrite() → 绘制时用 drawOffset()
+ * 作为 baseInstance/首顶点 → fence() 标记该区域正在被 GPU 使用。
+ */
+template<typename T>
+class StreamingBuffer {
+public:
+    static constexpr int REGION_COUNT = 3;  // 三缓冲：CPU 写一个区域时 GPU 可读其余区域
+
+    /**
+     * @brief 构造函数，分配不可变存储并持久映射。
+     * @param capacity 每个区域可容纳的元素数量。
+     * @param target 缓冲目标，默认GL_ARRAY_BUFFER。
+     */
+    StreamingBuffer(size_t capacity, GLenum target = GL_ARRAY_BUFFER)
+        : m_target(target), m_capacity(capacity) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        m_size = m_capacity * sizeof(T) * REGION_COUNT;
+
+        glGenBuffers(1, &m_id);
+        bind();
+        glBufferStorage(m_target, m_size, nullptr, flags);
+        m_mapped = static_cast<T*>(glMapBufferRange(m_target, 0, m_size, flags));
+        unbind();
+    }
+
+    /**
+     * @brief 析构函数，解除映射并释放缓冲与 fence。
+     */
+    ~StreamingBuffer() {
+        for (GLsync& sync : m_fences) {
+            if (sync) glDeleteSync(sync);
+        }
+        bind();
+        glUnmapBuffer(m_target);
+        unbind();
+        glDeleteBuffers(1, &m_id);
+    }
+
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    /**
+     * @brief 绑定缓冲。
+     */
+    void bind() const {
+        glBindBuffer(m_target, m_id);
+    }
+
+    /**
+     * @brief 解绑缓冲。
+     */
+    void unbind() const {
+        glBindBuffer(m_target, 0);
+    }
+
+    /**
+     * @brief 开始写入下一个区域，必要时等待 GPU 释放该区域。
+     * @return 映射内存指针（可写入 capacity() 个元素）。
+     */
+    T* beginWrite() {
+        waitForRegion(m_writeRegion);
+        return m_mapped + m_writeRegion * m_capacity;
+    }
+
+    /**
+     * @brief 结束写入，写入的区域成为绘制区域。
+     */
+    void endWrite() {
+        m_drawRegion = m_writeRegion;
+        m_writeRegion = (m_writeRegion + 1) % REGION_COUNT;
+    }
+
+    /**
+     * @brief 在提交读取绘制区域的绘制命令后调用，插入 fence。
+     */
+    void fence() {
+        GLsync& sync = m_fences[m_drawRegion];
+        if (sync) glDeleteSync(sync);
+        sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    /**
+     * @brief 获取绘制区域的起始元素索引（用作 baseInstance 或首顶点）。
+     */
+    GLuint drawOffset() const { return static_cast<GLuint>(m_drawRegion * m_capacity); }
+
+    /**
+     * @brief 获取每个区域的元素容量。
+     */
+    size_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief 获取整个缓冲大小（字节）。
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief 获取缓冲ID。
+     */
+    GLuint id() const { return m_id; }
+
+private:
+    GLuint m_id = 0;
+    GLenum m_target;
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+    T* m_mapped = nullptr;
+    int m_writeRegion = 0;
+    int m_drawRegion = 0;
+    GLsync m_fences[REGION_COUNT] = {};
+
+    /**
+     * @brief 等待指定区域上一次绘制完成。
+     */
+    void waitForRegion(int region) {
+        GLsync& sync = m_fences[region];
+        if (!sync) return;
+        // 正常情况下两帧前的 fence 早已完成，这里只在 GPU 落后时才会阻塞
+        GLenum result = glClientWaitSync(sync, 0, 0);
+        while (result == GL_TIMEOUT_EXPIRED) {
+            result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);  // 1ms
+        }
+        glDeleteSync(sync);
+        sync = nullptr;
+    }
+};
+
+/**
+ * @class UniformBuffer
+ * @brief Uniform 缓冲对象（UBO），存放一个 std140 布局的结构体，并固定绑定到某个绑定点。
+ *
+ * 结构体 T 的成员布局必须与着色器中 layout(std140) 声明的 Uniform 块一致。
+ * 所有声明该块的程序通过 glUniformBlockBinding 指向同一绑定点，update() 一次即对全部程序生效。
+ */
+template<typename T>
+class UniformBuffer {
+public:
+    /**
+     * @brief 构造函数，分配缓冲并绑定到指定绑定点。
+     * @param binding Uniform 块绑定点。
+     */
+    explicit UniformBuffer(GLuint binding) : m_binding(binding) {
+        glGenBuffers(1, &m_id);
+        bind();
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(T), nullptr, GL_DYNAMIC_DRAW);
+        unbind();
+        glBindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_id);
+    }
+
+    /**
+     * @brief 析构函数，释放缓冲资源。
+     */
+    ~UniformBuffer() {
+        glDeleteBuffers(1, &m_id);
+    }
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    /**
+     * @brief 绑定缓冲。
+     */
+    void bind() const {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+    }
+
+    /**
+     * @brief 解绑缓冲。
+     */
+    void unbind() const {
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    /**
+     * @brief 上传整个结构体。
+     * @param data 新数据。
+     */
+    void update(const T& data) {
+        bind();
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(T), &data);
+        unbind();
+    }
+
+    /**
+     * @brief 获取绑定点。
+     */
+    GLuint binding() const { return m_binding; }
+
+    /**
+     * @brief 获取缓冲ID。
+     */
+    GLuint id() const { return m_id; }
+
+private:
+    GLuint m_id = 0;
+    GLuint m_binding = 0;
+};
+
 /**
  * @class VAO
  * @brief Vertex Array Object 封装类，用于管理顶点数组。
@@ -239,13 +445,13 @@ public:
     
     /**
      * @brief 添加实例化VBO并配置属性（设置 divisor = 1）
-     * @param vbo 实例化VBO对象。
+     * @param vbo 实例化缓冲对象（VBO 或 StreamingBuffer）。
      * @param layout 属性布局，如"4f 4f 4f 4f"（用于mat4）。
      * @param startIndex 起始属性索引。
      * @param divisor 实例化分频器，默认1（每个实例更新一次）。
      */
-    template<typename T>
-    void addInstancedVBO(const VBO<T>& vbo, const std::string& layout, GLuint startIndex, GLuint divisor = 1) {
+    template<typename BufferT>
+    void addInstancedVBO(const BufferT& vbo, const std::string& layout, GLuint startIndex, GLuint divisor = 1) {
         bind();
         vbo.bind();
 
@@ -301,13 +507,23 @@ public:
      */
     void draw(GLenum mode = GL_TRIANGLES, GLsizei count = 0, size_t offset = 0) const {
         bind();
+        drawBound(mode, count, offset);
+        unbind();
+    }
+
+    /**
+     * @brief 在 VAO 已绑定的前提下绘制，不做绑定/解绑（供渲染队列连续绘制同一 VAO 使用）。
+     * @param mode 模式，默认GL_TRIANGLES。
+     * @param count 指定count（无EBO时），默认0使用自动计算。
+     * @param offset 偏移，默认0。
+     */
+    void drawBound(GLenum mode = GL_TRIANGLES, GLsizei count = 0, size_t offset = 0) const {
         if (m_hasEBO) {
             glDrawElements(mode, m_eboCount, m_eboType, reinterpret_cast<void*>(offset * getTypeSize(m_eboType)));
         }
         else {
             glDrawArrays(mode, offset, count ? count : m_vertexCount);
         }
-        unbind();
     }
 
     /**
@@ -315,17 +531,39 @@ public:
      * @param instanceCount 实例数量
      * @param indexCount 索引数量（使用EBO时）
      * @param mode 模式，默认GL_TRIANGLES
+     * @param baseInstance 实例属性起始偏移（用于 StreamingBuffer 的当前区域），默认0
      */
-    void drawInstanced(GLsizei instanceCount, GLsizei indexCount = 0, GLenum mode = GL_TRIANGLES) const {
+    void drawInstanced(GLsizei instanceCount, GLsizei indexCount = 0, GLenum mode = GL_TRIANGLES, GLuint baseInstance = 0) const {
         bind();
+        drawInstancedBound(instanceCount, indexCount, mode, baseInstance);
+        unbind();
+    }
+
+    /**
+     * @brief 在 VAO 已绑定的前提下实例化绘制，不做绑定/解绑
+     * @param instanceCount 实例数量
+     * @param indexCount 索引数量（使用EBO时）
+     * @param mode 模式，默认GL_TRIANGLES
+     * @param baseInstance 实例属性起始偏移，默认0
+     */
+    void drawInstancedBound(GLsizei instanceCount, GLsizei indexCount = 0, GLenum mode = GL_TRIANGLES, GLuint baseInstance = 0) const {
         if (m_hasEBO) {
             GLsizei count = indexCount > 0 ? indexCount : m_eboCount;
-            glDrawElementsInstanced(mode, count, m_eboType, nullptr, instanceCount);
+            if (baseInstance == 0) {
+                glDrawElementsInstanced(mode, count, m_eboType, nullptr, instanceCount);
+            }
+            else {
+                glDrawElementsInstancedBaseInstance(mode, count, m_eboType, nullptr, instanceCount, baseInstance);
+            }
         }
         else {
-            glDrawArraysInstanced(mode, 0, m_vertexCount, instanceCount);
+            if (baseInstance == 0) {
+                glDrawArraysInstanced(mode, 0, m_vertexCount, instanceCount);
+            }
+            else {
+                glDrawArraysInstancedBaseInstance(mode, 0, m_vertexCount, instanceCount, baseInstance);
+            }
         }
-        unbind();
     }
 
     /**
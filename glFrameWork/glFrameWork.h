@@ -6,6 +6,7 @@
 #include "texture.h"
 #include "core.h"
 #include "shaderManager.h"
+#include "gpuTimer.h"
 
 
 #endif // !
@@ -0,0 +1,155 @@
+﻿// gpuTimer.cpp
+#include "gpuTimer.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+GpuTimer::GpuTimer() {
+    m_supported = GLAD_GL_VERSION_3_3 != 0;
+    if (!m_supported) {
+        std::cout << "[GpuTimer] 当前上下文不支持 GL_TIME_ELAPSED 查询，GPU 计时关闭" << std::endl;
+    }
+}
+
+GpuTimer::~GpuTimer() {
+    for (FrameSlot& slot : m_slots) {
+        if (!slot.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+        }
+    }
+}
+
+void GpuTimer::beginFrame() {
+    if (!m_supported) return;
+
+    FrameSlot& slot = m_slots[m_frameIndex % FRAMES_IN_FLIGHT];
+    if (slot.pending && !tryResolve(slot)) {
+        ++m_droppedFrames;  // 结果仍未就绪：放弃这一帧，不等待
+    }
+    slot.zones.clear();
+    slot.segments.clear();
+    slot.usedQueries = 0;
+    slot.frame = m_frameIndex;
+    slot.pending = false;
+    m_stack.clear();
+    m_inFrame = true;
+}
+
+void GpuTimer::endFrame() {
+    if (!m_supported || !m_inFrame) return;
+
+    while (!m_stack.empty()) pop();  // 未配对的区段在帧尾关闭
+
+    FrameSlot& current = m_slots[m_frameIndex % FRAMES_IN_FLIGHT];
+    current.pending = !current.segments.empty();
+    m_inFrame = false;
+    ++m_frameIndex;
+
+    // 从最旧的帧开始读取已完成的结果
+    for (uint64_t age = FRAMES_IN_FLIGHT - 1; age >= 1; --age) {
+        if (m_frameIndex < age + 1) continue;
+        FrameSlot& slot = m_slots[(m_frameIndex - 1 - age) % FRAMES_IN_FLIGHT];
+        if (slot.pending) tryResolve(slot);
+    }
+}
+
+void GpuTimer::push(const char* name) {
+    if (!m_supported || !m_inFrame) return;
+
+    FrameSlot& slot = m_slots[m_frameIndex % FRAMES_IN_FLIGHT];
+    if (!m_stack.empty()) {
+        glEndQuery(GL_TIME_ELAPSED);  // 暂停父区段
+    }
+    const int parent = m_stack.empty() ? -1 : m_stack.back();
+    slot.zones.push_back(Zone{ name, parent, static_cast<uint32_t>(m_stack.size()) });
+    m_stack.push_back(static_cast<int>(slot.zones.size()) - 1);
+    beginSegment(slot, m_stack.back());
+}
+
+void GpuTimer::pop() {
+    if (!m_supported || !m_inFrame || m_stack.empty()) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    m_stack.pop_back();
+    if (!m_stack.empty()) {
+        beginSegment(m_slots[m_frameIndex % FRAMES_IN_FLIGHT], m_stack.back());  // 继续父区段
+    }
+}
+
+void GpuTimer::beginSegment(FrameSlot& slot, int zone) {
+    if (slot.usedQueries == slot.queries.size()) {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        slot.queries.push_back(query);
+    }
+    const GLuint query = slot.queries[slot.usedQueries++];
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    slot.segments.push_back(Segment{ query, zone });
+}
+
+bool GpuTimer::tryResolve(FrameSlot& slot) {
+    // 查询按提交顺序完成，最后一段可用即整帧可用
+    GLint available = 0;
+    glGetQueryObjectiv(slot.segments.back().query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+    slot.pending = false;
+
+    // 分段累加为独占时间，再把子区段加到父区段上（子区段总在父区段之后）
+    std::vector<uint64_t> inclusiveNs(slot.zones.size(), 0);
+    for (const Segment& segment : slot.segments) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(segment.query, GL_QUERY_RESULT, &elapsed);
+        inclusiveNs[segment.zone] += elapsed;
+    }
+    for (size_t i = slot.zones.size(); i-- > 0;) {
+        if (slot.zones[i].parent >= 0) inclusiveNs[slot.zones[i].parent] += inclusiveNs[i];
+    }
+    if (m_frameCallback) {
+        double frameMs = 0.0;
+        for (size_t i = 0; i < slot.zones.size(); ++i) {
+            if (slot.zones[i].depth == 0) frameMs += inclusiveNs[i] / 1e6;
+        }
+        m_frameCallback(slot.frame, frameMs);
+    }
+
+    if (slot.frame < m_lastResolvedFrame && m_lastFrameMs >= 0.0) return true;  // 已有更新的结果
+
+    // 同名同深度的区段合并
+    m_lastResults.clear();
+    double frameMs = 0.0;
+    for (size_t i = 0; i < slot.zones.size(); ++i) {
+        const Zone& zone = slot.zones[i];
+        const double ms = inclusiveNs[i] / 1e6;
+        if (zone.depth == 0) frameMs += ms;
+
+        auto it = m_lastResults.begin();
+        for (; it != m_lastResults.end(); ++it) {
+            if (it->depth == zone.depth && it->name == zone.name) break;
+        }
+        if (it == m_lastResults.end()) {
+            m_lastResults.push_back(ZoneResult{ zone.name, zone.depth, ms });
+        } else {
+            it->ms += ms;
+        }
+    }
+    m_lastFrameMs = frameMs;
+    m_lastResolvedFrame = slot.frame;
+    return true;
+}
+
+void GpuTimer::logLastFrame() const {
+    if (m_lastFrameMs < 0.0) {
+        std::cout << "[GpuTimer] 暂无 GPU 计时结果" << std::endl;
+        return;
+    }
+    const std::ios::fmtflags flags = std::cout.flags();
+    const std::streamsize precision = std::cout.precision();
+    std::cout << "[GpuTimer] 帧 " << m_lastResolvedFrame << "（落后 " << getLatencyFrames() << " 帧）GPU 总计 "
+              << std::fixed << std::setprecision(3) << m_lastFrameMs << " ms | 丢弃 " << m_droppedFrames << " 帧" << std::endl;
+    for (const ZoneResult& zone : m_lastResults) {
+        std::cout << "    " << std::string(zone.depth * 2, ' ') << std::left << std::setw(32) << zone.name
+                  << std::right << std::setw(10) << zone.ms << " ms" << std::endl;
+    }
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
@@ -0,0 +1,158 @@
+﻿// gpuTimer.h
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include "core.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class GpuTimer
+ * @brief 基于 GL_TIME_ELAPSED 查询的 GPU 分段计时。
+ *
+ * GL_TIME_ELAPSED 查询不能嵌套，因此每个时刻只有栈顶区段的查询处于活动状态：进入子区段时
+ * 结束父区段当前的查询段、开始子区段的查询，退出子区段时再为父区段开新的一段；
+ * 读回后把各段累加为独占时间，再自底向上求出包含子区段的总时间。
+ * 每帧的查询对象放在 FRAMES_IN_FLIGHT 个槽位组成的环中，只在结果可用时读取，从不等待 GPU；
+ * 某槽位轮转回来时结果仍不可用，则该帧丢弃（计入 getDroppedFrameCount）。
+ * 结果通常落后当前帧 1～3 帧；需要逐帧对齐的使用方通过 setFrameCallback 按帧号接收每个读回的结果。
+ */
+class GpuTimer {
+public:
+    static constexpr int FRAMES_IN_FLIGHT = 4;
+
+    // 读回一帧时调用：帧号（beginFrame 时的 getFrameIndex()）与所有顶层区段的耗时之和（毫秒）
+    using FrameCallback = std::function<void(uint64_t frame, double ms)>;
+
+    /**
+     * @brief 一个区段在某帧的 GPU 耗时（包含子区段）
+     */
+    struct ZoneResult {
+        std::string name;
+        uint32_t depth{ 0 };
+        double ms{ 0.0 };
+    };
+
+    GpuTimer();
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /**
+     * @brief 当前上下文是否支持计时查询（OpenGL 3.3+）
+     */
+    bool isSupported() const { return m_supported; }
+
+    /**
+     * @brief 开始一帧（复用本槽位的查询对象）
+     */
+    void beginFrame();
+
+    /**
+     * @brief 结束一帧，并非阻塞地读取已完成的旧帧
+     */
+    void endFrame();
+
+    /**
+     * @brief 进入/退出一个区段（名称须为长期有效的字符串，通常是字面量）
+     */
+    void push(const char* name);
+    void pop();
+
+    /**
+     * @brief 每读回一帧调用一次 callback（同一次 endFrame 可能读回多帧，丢弃的帧不会回调）
+     */
+    void setFrameCallback(FrameCallback callback) { m_frameCallback = std::move(callback); }
+
+    /**
+     * @brief 下一次 beginFrame 开始的帧号
+     */
+    uint64_t getFrameIndex() const { return m_frameIndex; }
+
+    /**
+     * @brief 最近一个已读回帧的各区段耗时（按首次进入顺序）
+     */
+    const std::vector<ZoneResult>& getLastResults() const { return m_lastResults; }
+
+    /**
+     * @brief 最近一个已读回帧所有顶层区段的耗时之和（毫秒），尚无结果时为 -1
+     */
+    double getLastFrameMs() const { return m_lastFrameMs; }
+
+    /**
+     * @brief 最近一个已读回帧落后当前帧的帧数
+     */
+    uint64_t getLatencyFrames() const { return m_frameIndex - m_lastResolvedFrame; }
+
+    uint64_t getDroppedFrameCount() const { return m_droppedFrames; }
+
+    /**
+     * @brief 打印最近一个已读回帧的区段耗时
+     */
+    void logLastFrame() const;
+
+private:
+    struct Zone {
+        const char* name;
+        int parent;       // 父区段索引（顶层为 -1）
+        uint32_t depth;
+    };
+
+    struct Segment {
+        GLuint query;
+        int zone;
+    };
+
+    struct FrameSlot {
+        std::vector<Zone> zones;
+        std::vector<Segment> segments;
+        std::vector<GLuint> queries;   // 查询对象池（只增不减）
+        size_t usedQueries{ 0 };
+        uint64_t frame{ 0 };
+        bool pending{ false };         // 已提交、尚未读回
+    };
+
+    void beginSegment(FrameSlot& slot, int zone);
+    bool tryResolve(FrameSlot& slot);
+
+    bool m_supported{ false };
+    FrameSlot m_slots[FRAMES_IN_FLIGHT];
+    std::vector<int> m_stack;          // 当前打开的区段
+    uint64_t m_frameIndex{ 0 };
+    bool m_inFrame{ false };
+
+    std::vector<ZoneResult> m_lastResults;
+    double m_lastFrameMs{ -1.0 };
+    uint64_t m_lastResolvedFrame{ 0 };
+    uint64_t m_droppedFrames{ 0 };
+    FrameCallback m_frameCallback;
+};
+
+/**
+ * @class GpuTimerScope
+ * @brief RAII 区段，timer 为空（如无头模式）时不做任何事。
+ */
+class GpuTimerScope {
+public:
+    GpuTimerScope(GpuTimer* timer, const char* name) : m_timer(timer) {
+        if (m_timer) m_timer->push(name);
+    }
+    ~GpuTimerScope() {
+        if (m_timer) m_timer->pop();
+    }
+
+    GpuTimerScope(const GpuTimerScope&) = delete;
+    GpuTimerScope& operator=(const GpuTimerScope&) = delete;
+
+private:
+    GpuTimer* m_timer;
+};
+
+#define GPU_TIMER_CONCAT_INNER(a, b) a##b
+#define GPU_TIMER_CONCAT(a, b) GPU_TIMER_CONCAT_INNER(a, b)
+#define GPU_TIMER_SCOPE(timer, name) GpuTimerScope GPU_TIMER_CONCAT(gpuTimerScope_, __LINE__)(timer, name)
+
+#endif // GPU_TIMER_H
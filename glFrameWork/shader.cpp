@@ -6,6 +6,70 @@
 #include <fstream>
 #include <sstream>
 
+// ========================================================================
+// UniformLocationCache 实现
+// ========================================================================
+
+void UniformLocationCache::build(GLuint program) {
+    clear();
+
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    if (uniformCount <= 0 || maxNameLength <= 0) return;
+
+    std::string name(maxNameLength, '\0');
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLsizei length = 0;
+        GLint arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, maxNameLength, &length, &arraySize, &type, &name[0]);
+        std::string uniformName = name.substr(0, length);
+
+        GLint location = glGetUniformLocation(program, uniformName.c_str());
+        if (location < 0) continue;  // Uniform 块成员没有独立位置
+
+        insert(uniformName, location);
+
+        // 数组：驱动返回 "name[0]"，同时登记 "name" 和每个元素 "name[i]"
+        const size_t bracket = uniformName.rfind("[0]");
+        if (bracket != std::string::npos && bracket + 3 == uniformName.size()) {
+            const std::string baseName = uniformName.substr(0, bracket);
+            insert(baseName, location);
+            for (GLint element = 1; element < arraySize; ++element) {
+                const std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                insert(elementName, glGetUniformLocation(program, elementName.c_str()));
+            }
+        }
+    }
+}
+
+UniformLocationCache& UniformLocationCache::operator=(const UniformLocationCache& other) {
+    if (this == &other) return *this;
+    clear();
+    for (const auto& [name, location] : other.m_locations) {
+        m_names.emplace_back(name);
+        m_locations.emplace(m_names.back(), location);
+    }
+    return *this;
+}
+
+void UniformLocationCache::insert(const std::string& name, GLint location) {
+    auto it = m_locations.find(name);
+    if (it != m_locations.end()) {
+        it->second = location;
+        return;
+    }
+    m_names.push_back(name);
+    m_locations.emplace(m_names.back(), location);
+}
+
+GLint UniformLocationCache::find(std::string_view name) const {
+    auto it = m_locations.find(name);
+    return it != m_locations.end() ? it->second : -1;
+}
+
 Shader& Shader::create(const char* vertexPath, const char* fragmentPath){
     this->~Shader(); // 如果存在旧的着色器程序，先销毁
     // 创建新的着色器程序
@@ -75,6 +139,9 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     glLinkProgram(mProgID);
     checkShaderErrors(mProgID, "LINK"); // 检查链接错误
     
+    // 枚举活跃 Uniform，建立位置缓存
+    m_uniformCache.build(mProgID);
+    
     // 删除着色器对象（已经链接到程序中，不再需要）
     GL_CALL(glDeleteShader(VS));
     GL_CALL(glDeleteShader(FS));
@@ -96,6 +163,13 @@ GLuint Shader::getAttribLocation(const char* name) { // 获取属性变量位置
     return GL_CALL(glGetAttribLocation(mProgID, name));
 }
 
+bool Shader::bindUniformBlock(const char* blockName, GLuint binding) {
+    GLuint blockIndex = GL_CALL(glGetUniformBlockIndex(mProgID, blockName));
+    if (blockIndex == GL_INVALID_INDEX) return false;
+    GL_CALL(glUniformBlockBinding(mProgID, blockIndex, binding));
+    return true;
+}
+
 void Shader::end() { // 停用着色器程序
 	GL_CALL(glUseProgram(0));
     m_isBound = false;
@@ -127,31 +201,31 @@ void Shader::checkShaderErrors(GLuint target, std::string type) {
 // ========================================================================
 
 void Shader::setFloat(const char* name, float value) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin(); // 如果未激活，先激活
     GL_CALL(glUniform1f(location, value));
 }
 
 void Shader::setInt(const char* name, int value) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform1i(location, value));
 }
 
 void Shader::setVec2(const char* name, float x, float y) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform2f(location, x, y));
 }
 
 void Shader::setVec3(const char* name, float x, float y, float z) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform3f(location, x, y, z));
 }
 
 void Shader::setVec4(const char* name, float x, float y, float z, float w) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform4f(location, x, y, z, w));
 }
@@ -161,25 +235,25 @@ void Shader::setVec4(const char* name, const glm::vec4& value) {
 }
 
 void Shader::setMat2(const char* name, const glm::mat2& mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
 }
 
 void Shader::setMat3(const char* name, const glm::mat3& mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
 }
 
 void Shader::setMat4(const char* name, const glm::mat4& mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
 }
 
 void Shader::setMat4(const char* name, const float* mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, mat));
 }
@@ -189,53 +263,82 @@ void Shader::setMat4(const char* name, const float* mat) {
 // ========================================================================
 
 void Shader::setUniform1i(const char* name, int value) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform1i(location, value));
 }
 
 void Shader::setUniform2i(const char* name, int v0, int v1) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform2i(location, v0, v1));
 }
 
 void Shader::setUniform3i(const char* name, int v0, int v1, int v2) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform3i(location, v0, v1, v2));
 }
 
 void Shader::setUniform4i(const char* name, int v0, int v1, int v2, int v3) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform4i(location, v0, v1, v2, v3));
 }
 
 void Shader::setUniform1f(const char* name, float value) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform1f(location, value));
 }
 
 void Shader::setUniform2f(const char* name, float v0, float v1) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
 	GL_CALL(glUniform2f(location, v0, v1));
 }
 
 void Shader::setUniform3f(const char* name, float v0, float v1, float v2) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform3f(location, v0, v1, v2));
 }
 
 void Shader::setUniform4f(const char* name, float v0, float v1, float v2, float v3) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform4f(location, v0, v1, v2, v3));
 }
 
+// ========================================================================
+// Shader 句柄版本的 Uniform 设置函数
+// ========================================================================
+
+void Shader::setInt(UniformHandle handle, int value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform1i(handle.location, value));
+}
+
+void Shader::setFloat(UniformHandle handle, float value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform1f(handle.location, value));
+}
+
+void Shader::setVec3(UniformHandle handle, const glm::vec3& value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform3f(handle.location, value.x, value.y, value.z));
+}
+
+void Shader::setVec4(UniformHandle handle, const glm::vec4& value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform4f(handle.location, value.x, value.y, value.z, value.w));
+}
+
+void Shader::setMat4(UniformHandle handle, const glm::mat4& mat) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(mat)));
+}
+
 // ========================================================================
 // ComputeShader 类实现
 // ========================================================================
@@ -296,6 +399,9 @@ ComputeShader::ComputeShader(const char* computePath) {
     glLinkProgram(mProgID);
     checkShaderErrors(mProgID, "LINK"); // 检查链接错误
     
+    // 枚举活跃 Uniform，建立位置缓存
+    m_uniformCache.build(mProgID);
+    
     // 删除着色器对象（已经链接到程序中，不再需要）
     GL_CALL(glDeleteShader(CS));
 }
@@ -353,31 +459,31 @@ void ComputeShader::checkShaderErrors(GLuint target, std::string type) {
 // ========================================================================
 
 void ComputeShader::setFloat(const char* name, float value) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform1f(location, value));
 }
 
 void ComputeShader::setInt(const char* name, int value) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform1i(location, value));
 }
 
 void ComputeShader::setVec2(const char* name, float x, float y) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform2f(location, x, y));
 }
 
 void ComputeShader::setVec3(const char* name, float x, float y, float z) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform3f(location, x, y, z));
 }
 
 void ComputeShader::setVec4(const char* name, float x, float y, float z, float w) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniform4f(location, x, y, z, w));
 }
@@ -387,25 +493,54 @@ void ComputeShader::setVec4(const char* name, const glm::vec4& value) {
 }
 
 void ComputeShader::setMat2(const char* name, const glm::mat2& mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
 }
 
 void ComputeShader::setMat3(const char* name, const glm::mat3& mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
 }
 
 void ComputeShader::setMat4(const char* name, const glm::mat4& mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
 }
 
 void ComputeShader::setMat4(const char* name, const float* mat) {
-    GLint location = GL_CALL(glGetUniformLocation(mProgID, name));
+    GLint location = m_uniformCache.find(name);
     if (!m_isBound) begin();
     GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, mat));
-}
\ No newline at end of file
+}
+
+// ========================================================================
+// ComputeShader 句柄版本的 Uniform 设置函数
+// ========================================================================
+
+void ComputeShader::setInt(UniformHandle handle, int value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform1i(handle.location, value));
+}
+
+void ComputeShader::setFloat(UniformHandle handle, float value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform1f(handle.location, value));
+}
+
+void ComputeShader::setVec3(UniformHandle handle, const glm::vec3& value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform3f(handle.location, value.x, value.y, value.z));
+}
+
+void ComputeShader::setVec4(UniformHandle handle, const glm::vec4& value) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniform4f(handle.location, value.x, value.y, value.z, value.w));
+}
+
+void ComputeShader::setMat4(UniformHandle handle, const glm::mat4& mat) {
+    if (!m_isBound) begin();
+    GL_CALL(glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(mat)));
+}
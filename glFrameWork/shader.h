@@ -1,10 +1,73 @@
 ﻿#pragma once
 
 #include "core.h"
+#include <deque>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+/**
+ * @struct UniformHandle
+ * @brief 预先解析的 Uniform 位置句柄。
+ *
+ * 在初始化时通过 getUniformHandle() 解析一次，之后每帧直接按句柄设置，跳过名称查找。
+ */
+struct UniformHandle {
+    GLint location{ -1 };
+
+    /**
+     * @brief 句柄是否对应一个活跃的 Uniform。
+     */
+    bool isValid() const { return location >= 0; }
+};
+
+/**
+ * @class UniformLocationCache
+ * @brief 着色器程序的 Uniform 位置缓存。
+ *
+ * 链接完成后枚举程序中所有活跃 Uniform 一次性填充，之后按名称查找不再调用 glGetUniformLocation。
+ * 未找到的名称返回 -1，与驱动对非活跃 Uniform 的行为一致（glUniform* 会忽略 -1）。
+ * 以 std::string_view 为键（指向缓存自有的名称），查找时不构造临时 std::string，不分配内存。
+ */
+class UniformLocationCache {
+public:
+    UniformLocationCache() = default;
+    // 复制时键须重新指向新缓存自己的名称；移动时 deque 整体转移，元素地址不变
+    UniformLocationCache(const UniformLocationCache& other) { *this = other; }
+    UniformLocationCache& operator=(const UniformLocationCache& other);
+    UniformLocationCache(UniformLocationCache&&) = default;
+    UniformLocationCache& operator=(UniformLocationCache&&) = default;
+
+    /**
+     * @brief 枚举程序的活跃 Uniform 并填充缓存。
+     * @param program 已链接的程序ID。
+     */
+    void build(GLuint program);
+
+    /**
+     * @brief 查找 Uniform 位置。
+     * @param name Uniform 名称。
+     * @return GLint 位置，不存在时返回 -1。
+     */
+    GLint find(std::string_view name) const;
+
+    /**
+     * @brief 清空缓存。
+     */
+    void clear() { m_locations.clear(); m_names.clear(); }
+
+private:
+    /**
+     * @brief 登记名称（已存在时覆盖位置）。
+     */
+    void insert(const std::string& name, GLint location);
+
+    std::deque<std::string> m_names;                          // 名称存储（deque 追加时元素地址不变）
+    std::unordered_map<std::string_view, GLint> m_locations;  // 名称到位置的映射（键指向 m_names）
+};
+
 /**
  * @class Shader
  * @brief OpenGL着色器程序封装类。
@@ -58,6 +121,28 @@ public:
      */
 	GLuint getAttribLocation(const char* name); // get the location of an attribute variable in the shader
 
+    /**
+     * @brief 获取 Uniform 变量的位置（查询链接时建立的缓存）。
+     * @param name Uniform 名称。
+     * @return GLint 位置，不存在时返回 -1。
+     */
+    GLint getUniformLocation(const char* name) const { return m_uniformCache.find(name); }
+
+    /**
+     * @brief 获取预解析的 Uniform 句柄，用于每帧频繁设置的 Uniform。
+     * @param name Uniform 名称。
+     * @return UniformHandle 句柄。
+     */
+    UniformHandle getUniformHandle(const char* name) const { return UniformHandle{ getUniformLocation(name) }; }
+
+    /**
+     * @brief 将 Uniform 块关联到绑定点。
+     * @param blockName Uniform 块名称。
+     * @param binding 绑定点。
+     * @return 程序中声明了该块时返回 true。
+     */
+    bool bindUniformBlock(const char* blockName, GLuint binding);
+
     /**
      * @brief 停用着色器程序。
      */
@@ -75,6 +160,7 @@ private:
 private:
 	GLuint mProgID{ 0 };
     bool m_isBound{ false };  // 跟踪 Shader 是否已激活
+    UniformLocationCache m_uniformCache;  // Uniform 位置缓存
 
 public:
     /**
@@ -158,6 +244,22 @@ public:
      */
     void setMat3(const char* name, const glm::mat3& mat);
 
+    // ------------------------------------------------------------------------
+    // 句柄版本的设置函数（热路径使用，无名称查找）
+    // ------------------------------------------------------------------------
+    void setInt(UniformHandle handle, int value);
+    void setFloat(UniformHandle handle, float value);
+    void setVec3(UniformHandle handle, const glm::vec3& value);
+    void setVec4(UniformHandle handle, const glm::vec4& value);
+    void setMat4(UniformHandle handle, const glm::mat4& mat);
+
+    void set(UniformHandle handle, bool value) { setInt(handle, (int)value); }
+    void set(UniformHandle handle, int value) { setInt(handle, value); }
+    void set(UniformHandle handle, float value) { setFloat(handle, value); }
+    void set(UniformHandle handle, const glm::vec3& value) { setVec3(handle, value); }
+    void set(UniformHandle handle, const glm::vec4& value) { setVec4(handle, value); }
+    void set(UniformHandle handle, const glm::mat4& value) { setMat4(handle, value); }
+
 public:
     // 传统 OpenGL 命名风格的设置函数
 	void setUniform1i(const char* name, int value); // set an integer uniform variable in the shader
@@ -234,6 +336,20 @@ public:
      */
     void wait(GLbitfield barriers = GL_ALL_BARRIER_BITS);
 
+    /**
+     * @brief 获取 Uniform 变量的位置（查询链接时建立的缓存）。
+     * @param name Uniform 名称。
+     * @return GLint 位置，不存在时返回 -1。
+     */
+    GLint getUniformLocation(const char* name) const { return m_uniformCache.find(name); }
+
+    /**
+     * @brief 获取预解析的 Uniform 句柄。
+     * @param name Uniform 名称。
+     * @return UniformHandle 句柄。
+     */
+    UniformHandle getUniformHandle(const char* name) const { return UniformHandle{ getUniformLocation(name) }; }
+
 private:
     /**
      * @brief 检查着色器编译或链接错误。
@@ -245,6 +361,7 @@ private:
 private:
     GLuint mProgID{ 0 };
     bool m_isBound{ false };
+    UniformLocationCache m_uniformCache;  // Uniform 位置缓存
 
 public:
     // Uniform 设置函数
@@ -285,6 +402,22 @@ public:
     void setMat4(const char* name, const glm::mat4& mat);
     void setMat4(const char* name, const float* mat);
 
+    // ------------------------------------------------------------------------
+    // 句柄版本的设置函数（热路径使用，无名称查找）
+    // ------------------------------------------------------------------------
+    void setInt(UniformHandle handle, int value);
+    void setFloat(UniformHandle handle, float value);
+    void setVec3(UniformHandle handle, const glm::vec3& value);
+    void setVec4(UniformHandle handle, const glm::vec4& value);
+    void setMat4(UniformHandle handle, const glm::mat4& mat);
+
+    void set(UniformHandle handle, bool value) { setInt(handle, (int)value); }
+    void set(UniformHandle handle, int value) { setInt(handle, value); }
+    void set(UniformHandle handle, float value) { setFloat(handle, value); }
+    void set(UniformHandle handle, const glm::vec3& value) { setVec3(handle, value); }
+    void set(UniformHandle handle, const glm::vec4& value) { setVec4(handle, value); }
+    void set(UniformHandle handle, const glm::mat4& value) { setMat4(handle, value); }
+
     // 通用 set 函数重载
     /**
      * @brief 通用 Uniform 设置函数 (bool -> int)。
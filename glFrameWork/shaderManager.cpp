@@ -23,6 +23,11 @@ bool ShaderManager::loadShader(const std::string& name, const char* vertexPath,
         return false;
     }
 
+    // 自动关联已登记的 Uniform 块
+    for (const auto& [blockName, binding] : m_blockBindings) {
+        shader->bindUniformBlock(blockName.c_str(), binding);
+    }
+
     m_shaders[name] = std::move(shader);
     return true;
 }
@@ -35,6 +40,13 @@ Shader* ShaderManager::getShader(const std::string& name) const {
     return nullptr;
 }
 
+void ShaderManager::setUniformBlockBinding(const std::string& blockName, GLuint binding) {
+    m_blockBindings[blockName] = binding;
+    for (auto& [name, shader] : m_shaders) {
+        shader->bindUniformBlock(blockName.c_str(), binding);
+    }
+}
+
 void ShaderManager::clear() {
     m_shaders.clear();
 }
\ No newline at end of file
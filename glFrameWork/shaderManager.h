@@ -40,6 +40,14 @@ public:
      */
     Shader* getShader(const std::string& name) const;
 
+    /**
+     * @brief 登记 Uniform 块的绑定点。
+     * 之后加载的每个声明了该块的 Shader 都会自动关联到该绑定点，已加载的 Shader 也会立即更新。
+     * @param blockName Uniform 块名称。
+     * @param binding 绑定点。
+     */
+    void setUniformBlockBinding(const std::string& blockName, GLuint binding);
+
     /**
      * @brief 释放所有Shader资源。
      */
@@ -47,6 +55,7 @@ public:
 
 private:
     std::unordered_map<std::string, std::unique_ptr<Shader>> m_shaders;  // Shader存储容器
+    std::unordered_map<std::string, GLuint> m_blockBindings;  // Uniform 块名称到绑定点的映射
 };
 
 #endif // SHADER_MANAGER_H
\ No newline at end of file
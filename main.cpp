@@ -1,12 +1,63 @@
-#include "engine/engine.h"
+﻿#include "engine/engine.h"
+#include "engine/profiler.h"
+#include "engine/frameStats.h"
+#include "engine/inputRecorder.h"
+#include "engine/snapshot.h"
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+int main(int argc, char** argv) {
+    // --trace-frames N [--trace-file path]：启动后录制 N 帧时间线
+    int traceFrames = 0;
+    std::string traceFile = "profile_trace.json";
+    std::string frameStatsCsv;  // --frame-stats-csv path：退出时导出帧时间统计
+    std::string recordPath;     // --record path：录制输入日志
+    std::string replayPath;     // --replay path：回放输入日志（播完退出）
+    std::string snapshotPath;   // --load-snapshot path：创建场景后恢复快照
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace-frames") == 0 && i + 1 < argc) {
+            traceFrames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--trace-file") == 0 && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--frame-stats-csv") == 0 && i + 1 < argc) {
+            frameStatsCsv = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--load-snapshot") == 0 && i + 1 < argc) {
+            snapshotPath = argv[++i];
+        }
+    }
 
-int main() {
     auto engine = new Engine();
     engine->init();
+    
+    // 录制/回放须在创建场景之前确定随机种子
+    if (!replayPath.empty()) {
+        if (engine->inputRecorder->startReplay(replayPath)) {
+            engine->randomSeed = engine->inputRecorder->getSeed();
+        }
+    } else if (!recordPath.empty()) {
+        const uint32_t seed = std::random_device{}() | 1u;  // 非零
+        engine->randomSeed = seed;
+        engine->inputRecorder->startRecording(recordPath, seed);
+    }
+    
     engine->setupDemoData();
+    if (!snapshotPath.empty()) {
+        engine->snapshot->load(snapshotPath);
+    }
+    if (traceFrames > 0) {
+        Profiler::instance().beginCapture(traceFrames, traceFile);
+    }
 	engine->render();
+    if (!frameStatsCsv.empty()) {
+        engine->frameStats->logSummary(engine->frameStats->getSampleCount());
+        engine->frameStats->writeCsv(frameStatsCsv);
+    }
     delete engine;
     return 0;
 }
-
-
@@ -1,7 +1,9 @@
 #pragma once
 
 // Ԥ
-#ifdef DEBUG
+// DEBUG builds report GL errors through the KHR_debug callback (debugOutput.h); -DGL_DEBUG_CONTEXT=ON adds a debug context.
+// Define GL_CHECK_EACH_CALL to also call glGetError after every GL_CALL; each check syncs with the driver.
+#ifdef GL_CHECK_EACH_CALL
 #define GL_CALL(func) func; checkError(); // call the function and check for errors after it
 #else
 #define GL_CALL(func) func // call the function without checking for errors
@@ -0,0 +1,169 @@
+﻿// debugOutput.cpp
+#include "debugOutput.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // 同一条消息的计数
+    struct MessageRecord {
+        GLenum source;
+        GLenum type;
+        GLuint id;
+        GLenum severity;
+        std::string text;   // 首次出现时的内容
+        uint64_t count{ 0 };
+    };
+
+    std::mutex s_mutex;  // 异步输出时回调可能来自驱动线程
+    // 按哈希分桶；哈希相同时再比较来源、类型、ID 与内容，冲突的消息各自计数
+    std::unordered_map<uint64_t, std::vector<MessageRecord>> s_messages;
+    size_t s_distinctMessages = 0;
+    uint64_t s_totalMessages = 0;
+    bool s_installed = false;
+
+    const char* sourceName(GLenum source) {
+        switch (source) {
+            case GL_DEBUG_SOURCE_API: return "API";
+            case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "WINDOW_SYSTEM";
+            case GL_DEBUG_SOURCE_SHADER_COMPILER: return "SHADER_COMPILER";
+            case GL_DEBUG_SOURCE_THIRD_PARTY: return "THIRD_PARTY";
+            case GL_DEBUG_SOURCE_APPLICATION: return "APPLICATION";
+            default: return "OTHER";
+        }
+    }
+
+    const char* typeName(GLenum type) {
+        switch (type) {
+            case GL_DEBUG_TYPE_ERROR: return "ERROR";
+            case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "DEPRECATED";
+            case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "UNDEFINED";
+            case GL_DEBUG_TYPE_PORTABILITY: return "PORTABILITY";
+            case GL_DEBUG_TYPE_PERFORMANCE: return "PERFORMANCE";
+            case GL_DEBUG_TYPE_MARKER: return "MARKER";
+            default: return "OTHER";
+        }
+    }
+
+    const char* severityName(GLenum severity) {
+        switch (severity) {
+            case GL_DEBUG_SEVERITY_HIGH: return "HIGH";
+            case GL_DEBUG_SEVERITY_MEDIUM: return "MEDIUM";
+            case GL_DEBUG_SEVERITY_LOW: return "LOW";
+            default: return "NOTIFICATION";
+        }
+    }
+
+    // 严重级别从低到高的序号
+    int severityRank(GLenum severity) {
+        switch (severity) {
+            case GL_DEBUG_SEVERITY_HIGH: return 3;
+            case GL_DEBUG_SEVERITY_MEDIUM: return 2;
+            case GL_DEBUG_SEVERITY_LOW: return 1;
+            default: return 0;
+        }
+    }
+
+    bool shouldPrint(uint64_t count) {
+        // 第 1、10、100…… 次
+        while (count >= 10 && count % 10 == 0) count /= 10;
+        return count == 1;
+    }
+
+    void APIENTRY debugCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                GLsizei length, const GLchar* message, const void* /*userParam*/) {
+        // 有的驱动对不同内容复用同一 ID，因此连同消息内容一起去重
+        const std::string_view text(message, length >= 0 ? static_cast<size_t>(length) : std::char_traits<char>::length(message));
+        const uint64_t ids = (static_cast<uint64_t>(source & 0xFFFF) << 48) | (static_cast<uint64_t>(type & 0xFFFF) << 32) | id;
+        const uint64_t key = std::hash<std::string_view>{}(text) ^ (ids * 0x9E3779B97F4A7C15ull);
+
+        std::lock_guard<std::mutex> lock(s_mutex);
+        ++s_totalMessages;
+        std::vector<MessageRecord>& bucket = s_messages[key];
+        auto it = std::find_if(bucket.begin(), bucket.end(), [&](const MessageRecord& r) {
+            return r.source == source && r.type == type && r.id == id && r.text == text;
+        });
+        if (it == bucket.end()) {
+            bucket.push_back(MessageRecord{ source, type, id, severity, std::string(text) });
+            it = bucket.end() - 1;
+            ++s_distinctMessages;
+        }
+        MessageRecord& record = *it;
+        ++record.count;
+        if (!shouldPrint(record.count)) return;
+
+        std::ostream& out = (type == GL_DEBUG_TYPE_ERROR || severity == GL_DEBUG_SEVERITY_HIGH) ? std::cerr : std::cout;
+        out << "[GL " << severityName(severity) << "] " << sourceName(source) << "/" << typeName(type)
+            << " #" << id << ": " << record.text;
+        if (record.count > 1) out << "（已出现 " << record.count << " 次）";
+        out << std::endl;
+    }
+}
+
+bool installDebugOutput(GLenum minSeverity) {
+    if (!GLAD_GL_VERSION_4_3 || !glDebugMessageCallback) {
+        std::cout << "[DebugOutput] 当前上下文不支持 KHR_debug，调试输出关闭" << std::endl;
+        return false;
+    }
+
+    GLint flags = 0;
+    glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+    if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT)) {
+        std::cout << "[DebugOutput] 非调试上下文，驱动可能只报告部分消息" << std::endl;
+    }
+
+    glEnable(GL_DEBUG_OUTPUT);
+    glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(debugCallback, nullptr);
+    s_installed = true;
+    setDebugOutputMinSeverity(minSeverity);
+
+    std::cout << "[DebugOutput] 已安装 | 最小级别：" << severityName(minSeverity) << std::endl;
+    return true;
+}
+
+void setDebugOutputMinSeverity(GLenum minSeverity) {
+    if (!s_installed) return;
+    const GLenum severities[] = {
+        GL_DEBUG_SEVERITY_NOTIFICATION, GL_DEBUG_SEVERITY_LOW, GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_HIGH
+    };
+    for (GLenum severity : severities) {
+        const GLboolean enabled = severityRank(severity) >= severityRank(minSeverity) ? GL_TRUE : GL_FALSE;
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, severity, 0, nullptr, enabled);
+    }
+}
+
+void setDebugOutputSynchronous(bool synchronous) {
+    if (!s_installed) return;
+    if (synchronous) {
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    } else {
+        glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    }
+}
+
+void logDebugOutputSummary() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (!s_installed) return;
+
+    std::vector<const MessageRecord*> records;
+    records.reserve(s_distinctMessages);
+    for (const auto& [key, bucket] : s_messages) {
+        for (const MessageRecord& record : bucket) records.push_back(&record);
+    }
+    std::sort(records.begin(), records.end(), [](const MessageRecord* a, const MessageRecord* b) { return a->count > b->count; });
+
+    std::cout << "[DebugOutput] 共 " << s_totalMessages << " 条消息，" << records.size() << " 种" << std::endl;
+    const size_t shown = std::min<size_t>(records.size(), 10);
+    for (size_t i = 0; i < shown; ++i) {
+        const MessageRecord& record = *records[i];
+        std::cout << "    " << record.count << " × [" << severityName(record.severity) << "] "
+                  << sourceName(record.source) << "/" << typeName(record.type) << " #" << record.id
+                  << ": " << record.text << std::endl;
+    }
+}
@@ -0,0 +1,39 @@
+﻿// debugOutput.h
+#ifndef DEBUG_OUTPUT_H
+#define DEBUG_OUTPUT_H
+
+#include <glad/glad.h>
+
+/**
+ * @brief OpenGL 调试输出（KHR_debug / GL 4.3 核心）
+ *
+ * 驱动通过 glDebugMessageCallback 主动报告错误与警告，取代每次 GL 调用后的 glGetError 同步。
+ * 低于最小严重级别的消息在驱动侧用 glDebugMessageControl 关闭；同一条消息（来源、类型、ID、内容）
+ * 只在第 1、10、100…… 次出现时打印，其余计数，logDebugOutputSummary() 汇总重复最多的消息。
+ * 默认异步输出；需要在出错的调用处断点时用 setDebugOutputSynchronous(true)。
+ * 引擎在 DEBUG 构建中以 MEDIUM 级别安装；以 -DGL_DEBUG_CONTEXT=ON 配置时另请求调试上下文并降到 LOW。
+ */
+
+/**
+ * @brief 在当前上下文安装调试回调
+ * @param minSeverity 最小严重级别（GL_DEBUG_SEVERITY_HIGH / MEDIUM / LOW / NOTIFICATION）
+ * @return 上下文不支持调试输出时返回 false
+ */
+bool installDebugOutput(GLenum minSeverity = GL_DEBUG_SEVERITY_LOW);
+
+/**
+ * @brief 调整最小严重级别
+ */
+void setDebugOutputMinSeverity(GLenum minSeverity);
+
+/**
+ * @brief 同步输出：回调在出错的 GL 调用内执行（便于断点，代价较高）
+ */
+void setDebugOutputSynchronous(bool synchronous);
+
+/**
+ * @brief 打印收到的消息总数与重复最多的消息
+ */
+void logDebugOutputSummary();
+
+#endif // DEBUG_OUTPUT_H